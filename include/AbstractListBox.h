@@ -21,11 +21,23 @@ class AbstractListBox: public CursesWidget {
     std::string _name;
     std::vector<ListItem *> _items;
     int _firstprint;
+    std::vector<int> _changed_items;
+
+    /* Layout metrics, computed from the items when needed and kept until the
+       items change */
+
+    mutable bool _metrics_valid;
+    mutable int _max_name_len;
+
+    void invalidateMetrics();
+    void checkMetrics() const;
+    virtual void computeMetrics() const;
 
     virtual void redrawFrame();
     virtual void redrawSingleItem(unsigned int idx) = 0;
     virtual void redrawScrollIndicator() const = 0;
     virtual void redrawAllItems();
+    virtual void redrawChangedItems();
 
   public:
 
@@ -40,6 +52,10 @@ class AbstractListBox: public CursesWidget {
     virtual void removeItem(unsigned int idx);
     virtual void clearList();
 
+    /* Marks an item to be redrawn by the next draw() */
+
+    void itemChanged(unsigned int idx);
+
     /* Set attributes */
 
     void setName(const std::string & name);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "BuildListItem.h"
+#include "BuildSet.h"
+
+enum build_status { STATUS_INSTALLED, STATUS_UPGRADABLE, STATUS_TAGGED,
+                    STATUS_BLACKLISTED, STATUS_BUILDOPTIONS, STATUS_NONDEP,
+                    NUM_STATUSES };
+
+/*******************************************************************************
+
+Numbers every SlackBuild in the repository, category by category, so that sets
+of SlackBuilds can be stored as BuildSets. The SlackBuilds of each category
+have consecutive numbers. Also keeps a BuildSet for each status used by the
+filters.
+
+*******************************************************************************/
+class BuildIndex {
+
+  private:
+
+    std::vector<BuildListItem *> _builds;
+    std::vector<std::vector<BuildListItem *> > _categories;
+    std::vector<unsigned int> _first;
+    std::unordered_map<const BuildListItem *, unsigned int> _lookup;
+    BuildSet _status[NUM_STATUSES];
+    bool _dirty;
+
+    void readStatus(unsigned int idx);
+
+  public:
+
+    /* Constructor */
+
+    BuildIndex();
+
+    /* Numbering the SlackBuilds. slackbuilds must not be resized afterwards,
+       since pointers to its items are kept. */
+
+    void clear();
+    void create(std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    /* Updating statuses (non-dependencies excepted, since they come from the
+       dependency graph and are set separately). update() rereads one
+       SlackBuild whose status changed. When too many may have changed to
+       track, invalidate() instead, and the next refresh() rereads them all;
+       otherwise refresh() does nothing. */
+
+    void update(const BuildListItem * build);
+    void invalidate();
+    void refresh();
+    void setNonDeps(const std::vector<BuildListItem *> & nondeps);
+    const BuildSet & status(build_status which) const;
+
+    /* Access. first(ncategories) is the number of SlackBuilds. indexOf
+       returns -1 for a SlackBuild that is not in the index. */
+
+    unsigned int size() const;
+    unsigned int numCategories() const;
+    unsigned int first(unsigned int category) const;
+    const std::vector<BuildListItem *> & categoryBuilds(unsigned int category)
+                                                                        const;
+    BuildListItem * build(unsigned int idx) const;
+    int indexOf(const BuildListItem * build) const;
+};
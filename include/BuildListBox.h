@@ -1,8 +1,11 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <curses.h>
 #include "ListBox.h"
+#include "BuildListItem.h"
+#include "BuildSet.h"
 #include "MouseEvent.h"
 
 class TagList;
@@ -17,6 +20,9 @@ class BuildListBox: public ListBox {
   protected:
 
     TagList *_taglist;
+    const std::vector<BuildListItem *> *_source;
+    const BuildSet *_mask;
+    unsigned int _first;
 
     virtual void redrawFrame();
     virtual void redrawSingleItem(unsigned int idx);
@@ -28,6 +34,36 @@ class BuildListBox: public ListBox {
     BuildListBox();
     BuildListBox(WINDOW *win, const std::string & name);
 
+    /* Filling the list lazily. setSource() keeps a reference to the
+       SlackBuilds of the category and the set of SlackBuilds to show (NULL
+       for all of them), in which the category starts at first. The list is
+       only filled from them the first time it is used, so lists that are
+       never displayed cost almost nothing. Both must remain valid and
+       unchanged until then. */
+
+    void setSource(const std::vector<BuildListItem *> *source,
+                   const BuildSet *mask=NULL, unsigned int first=0);
+    bool pending() const;
+    void materialize();
+    void filteredItems(std::vector<BuildListItem *> & items) const;
+
+    /* Edit list */
+
+    void addItem(ListItem *item);
+    void removeItem(unsigned int idx);
+    void clearList();
+
+    /* Set and get attributes and items. These fill the list first if
+       needed. */
+
+    int setHighlight(int highlight);
+    int setHighlight(const std::string & name);
+    unsigned int numItems() const;
+    const std::string & highlightedName();
+    int highlightSearch(const std::string & pattern); 
+    ListItem * highlightedItem();
+    ListItem * itemByIdx(unsigned int idx);
+
     /* Tagging */
 
     void setTagList(TagList *taglist);
@@ -39,7 +75,9 @@ class BuildListBox: public ListBox {
 
     bool allTagged() const;
 
-    /* User interaction loop */
+    /* Drawing, mouse events, and user interaction loop */
 
+    virtual void draw(bool force=false);
+    virtual std::string handleMouseEvent(MouseEvent * mevent);
     virtual std::string exec(MouseEvent * mevent=NULL);
 };
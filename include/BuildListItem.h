@@ -7,13 +7,44 @@
 
 /*******************************************************************************
 
-List item that describes a SlackBuild
+Action to be applied to a SlackBuild in an InstallBox
+
+*******************************************************************************/
+enum build_action { ACTION_NONE, ACTION_INSTALL, ACTION_UPGRADE,
+                    ACTION_REINSTALL, ACTION_REMOVE, ACTION_BLACKLISTED };
+
+/*******************************************************************************
+
+List item that describes a SlackBuild. Unlike ListItem, the SlackBuild props
+are stored as typed fields: bools as bit flags, the action as an enum, and
+category, versions, and build numbers as interned strings shared between all
+SlackBuilds. The generic prop methods still work for these props, but code that
+handles many SlackBuilds at once should use the typed accessors.
 
 *******************************************************************************/
 class BuildListItem: public ListItem {
 
+  public:
+
+    // Bit flags for bool props
+
+    static const unsigned int INSTALLED = 1;
+    static const unsigned int UPGRADABLE = 2;
+    static const unsigned int TAGGED = 4;
+    static const unsigned int BLACKLISTED = 8;
+    static const unsigned int MARKED = 16;
+
   private:
 
+    // Typed props
+
+    unsigned int _flags;
+    build_action _action;
+    const std::string *_category;
+    const std::string *_installed_version, *_available_version;
+    const std::string *_installed_buildnum, *_available_buildnum;
+    std::string _requires, _package_name, _build_options;
+
     // Pointer to IgnoreVersions object
 
     const IgnoreVersions * _ignore_versions;
@@ -23,7 +54,12 @@ class BuildListItem: public ListItem {
     bool differsByKernel(const std::string & installed_version,
                          const std::string & available_version) const;
     bool ignoreVersion(const std::string & version) const;
-    bool upgradable() const;
+    bool checkUpgradable() const;
+
+    // Maps prop names to typed fields for the generic prop methods
+
+    static int fieldByName(const std::string & propname);
+    unsigned int flagByField(int field) const;
 
   public:
 
@@ -39,14 +75,63 @@ class BuildListItem: public ListItem {
 
     void setIgnoreVersions(IgnoreVersions * ignore_versions);
 
-    // Reads properties from repo 
+    // Generic prop methods (compatibility with ListItem)
+
+    void addProp(const std::string & propname, const std::string & value);
+    void addBoolProp(const std::string & propname, bool value);
+    int setProp(const std::string & propname, const std::string & value);
+    int setBoolProp(const std::string & propname, bool value);
+    bool checkProp(const std::string & propname) const;
+    const std::string & getProp(const std::string & propname) const;
+    bool getBoolProp(const std::string & propname) const;
 
-    void readInstalledProps(std::vector<std::string> & installedpkgs);
+    // Typed access to bool props
+
+    bool installed() const;
+    bool upgradable() const;
+    bool tagged() const;
+    bool blacklisted() const;
+    bool marked() const;
+    void setInstalled(bool installed);
+    void setUpgradable(bool upgradable);
+    void setTagged(bool tagged);
+    void setBlacklisted(bool blacklisted);
+    void setMarked(bool marked);
+
+    // Typed access to action
+
+    static const std::string & actionName(build_action action);
+    static build_action actionByName(const std::string & name);
+    build_action action() const;
+    void setAction(build_action action);
+
+    // Typed access to string props
+
+    const std::string & category() const;
+    const std::string & installedVersion() const;
+    const std::string & availableVersion() const;
+    const std::string & installedBuildNum() const;
+    const std::string & availableBuildNum() const;
+    const std::string & reqs() const;
+    const std::string & packageName() const;
+    const std::string & buildOptions() const;
+    void setCategory(const std::string & category);
+    void setInstalledVersion(const std::string & version);
+    void setAvailableVersion(const std::string & version);
+    void setInstalledBuildNum(const std::string & buildnum);
+    void setAvailableBuildNum(const std::string & buildnum);
+    void setReqs(const std::string & reqs);
+    void setPackageName(const std::string & package_name);
+    void setBuildOptions(const std::string & build_options);
+
+    // Reads properties from repo
+
+    void readInstalledProps();
     int readPropsFromRepo();
 
     // Determines BUILD number from last portion of package name
 
-    void parseBuildNum(std::string & build);
+    void parseBuildNum(const std::string & build);
 
     // Build options as string of environment variables
 
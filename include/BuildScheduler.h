@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sys/types.h>      // pid_t
+
+enum job_state { JOB_WAITING, JOB_RUNNING, JOB_DONE, JOB_FAILED,
+                 JOB_SKIPPED };
+
+struct buildjob {
+  std::string cmd;                // Shell command to run
+  std::string log;                // Output file
+  std::vector<int> prereqs;       // Jobs that must be done first
+  unsigned int jobclass;          // Jobs of each class have their own limit
+  job_state state;
+  int status;                     // Exit status once finished
+  pid_t pid;
+};
+
+/*******************************************************************************
+
+Runs shell commands in the background, several at a time, in an order that
+respects dependencies between them. Each job's output is written to its own log
+file, and its input is /dev/null. Jobs are started in the order they were
+added as soon as their prerequisites are done; if a prerequisite fails, the job
+is skipped. Jobs can be put in classes (e.g., downloading, building, and
+installing), each with its own limit on how many run at once.
+
+*******************************************************************************/
+class BuildScheduler {
+
+  private:
+
+    std::vector<buildjob> _jobs;
+    std::vector<unsigned int> _max_jobs, _nrunning_class;
+    unsigned int _nrunning;
+
+    int startJob(int idx);
+
+  public:
+
+    /* Constructor */
+
+    BuildScheduler();
+
+    /* Setting up */
+
+    void setMaxJobs(unsigned int max_jobs, unsigned int jobclass=0);
+    int addJob(const std::string & cmd, const std::string & log,
+               const std::vector<int> & prereqs, unsigned int jobclass=0);
+
+    /* Running. startReady() starts as many jobs as allowed and returns the
+       number started. waitJob() waits for a running job to finish and sets
+       its index; it returns 0, or 1 if no job is running. */
+
+    unsigned int startReady();
+    int waitJob(int & idx);
+    void markFailed(int idx);
+    bool finished() const;
+
+    /* Access */
+
+    unsigned int numJobs() const;
+    unsigned int numRunning() const;
+    const buildjob & job(int idx) const;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+/*******************************************************************************
+
+Set of SlackBuilds, stored as one bit per SlackBuild in the repository (see
+BuildIndex). Combining sets works on 64 SlackBuilds at a time, so filters and
+their combinations cost a few hundred word operations even for the whole
+repository.
+
+*******************************************************************************/
+class BuildSet {
+
+  private:
+
+    std::vector<uint64_t> _words;
+    unsigned int _size;
+
+    void clearTail();
+
+  public:
+
+    /* Constructor */
+
+    BuildSet();
+
+    /* Size (number of SlackBuilds) and setting all bits at once */
+
+    void resize(unsigned int size, bool value=false);
+    unsigned int size() const;
+    void fill(bool value);
+
+    /* Single bits */
+
+    void set(unsigned int idx, bool value=true);
+    bool test(unsigned int idx) const;
+
+    /* Combining with another set of the same size */
+
+    BuildSet & operator &= (const BuildSet & other);
+    BuildSet & operator |= (const BuildSet & other);
+    BuildSet & subtract(const BuildSet & other);
+
+    /* Number of bits set, overall or in [first, last) */
+
+    unsigned int count() const;
+    unsigned int count(unsigned int first, unsigned int last) const;
+
+    /* Index of the first bit set at or after idx, or size() if none */
+
+    unsigned int next(unsigned int idx) const;
+};
@@ -4,6 +4,7 @@
 #include <vector>
 #include <curses.h>
 #include "MouseEvent.h"
+#include "damage.h"
 
 /*******************************************************************************
 
@@ -29,7 +30,7 @@ class CursesWidget {
 
     int _highlighted_button;
     unsigned int _reserved_rows, _header_rows;
-    std::string _redraw_type;
+    unsigned int _damage;               // damage_region flags
     std::string _button_fg, _button_bg;
     std::string _bg_color, _fg_color;   // Default colors
 
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include "BuildListItem.h"
+
+/*******************************************************************************
+
+Dependency graph of the SlackBuilds repository. Each SlackBuild is a node with
+an integer ID, and requirements are stored as adjacency arrays in REQUIRES
+order, along with the reverse (which SlackBuilds require each node). The list
+of requirements (transitive closure) of each node is computed on first use and
+remembered, so repeated queries for overlapping dependency trees do not redo
+any work. The same is done for installed SlackBuilds that depend on a node.
+
+The graph refers to the list of SlackBuilds it was built from, so it must be
+cleared or rebuilt whenever that list is read again or the requirements of a
+SlackBuild change. Remembered answers depend on which SlackBuilds are
+installed, so installedChanged() must be called when that changes.
+
+*******************************************************************************/
+class DependencyGraph {
+
+  private:
+
+    const std::vector<std::vector<BuildListItem> > *_slackbuilds;
+    std::vector<BuildListItem *> _nodes;
+    std::vector<unsigned int> _category_offset;     // ID of first in category
+
+    // Adjacency arrays: requirements of node n are
+    // _adj[_adj_start[n]] ... _adj[_adj_start[n+1]-1], and SlackBuilds that
+    // require it are _rev[_rev_start[n]] ... _rev[_rev_start[n+1]-1]
+
+    std::vector<unsigned int> _adj_start, _rev_start;
+    std::vector<int> _adj, _rev;
+
+    // Problems found reading requirements
+
+    std::vector<char> _info_missing;    // .info file could not be read
+    std::vector<char> _missing_dep;     // A requirement is not in the repo
+
+    // Memoized closures. The state is 0 if not computed, 1 while being
+    // computed (to break cycles), and 2 when done.
+
+    std::vector<std::vector<int> > _closure, _inv_closure;
+    std::vector<int> _closure_check;
+    std::vector<char> _closure_state, _inv_state;
+    std::vector<BuildListItem *> _nondeps;
+    bool _nondeps_valid;
+
+    std::vector<unsigned int> _mark;
+    unsigned int _mark_gen;
+
+    void computeClosure(int node);
+    void computeInvClosure(int node);
+    void keepLastOccurrences(const std::vector<int> & seq, int node,
+                             std::vector<int> & list);
+
+  public:
+
+    /* Constructor */
+
+    DependencyGraph();
+
+    /* Building and clearing */
+
+    void create(std::vector<std::vector<BuildListItem> > & slackbuilds);
+    void clear();
+    void installedChanged();
+    bool builtFor(const std::vector<std::vector<BuildListItem> > &
+                  slackbuilds) const;
+
+    /* Node IDs. id() returns -1 if the SlackBuild is not in the graph. */
+
+    int id(const BuildListItem & build) const;
+
+    /* Queries. The graph is built first if it was not built from
+       slackbuilds. */
+
+    // Requirements of a SlackBuild in build order. Returns 1 if a requirement
+    // is not found in the repository, 2 if a .info file is missing, or 0
+    // otherwise.
+
+    int reqsOrder(const BuildListItem & build,
+                  std::vector<BuildListItem *> & reqlist,
+                  std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    // Merged build order for several SlackBuilds: the requirements of each,
+    // followed by the SlackBuild itself, with each SlackBuild listed only the
+    // first time it is needed. Return value as in reqsOrder.
+
+    int planOrder(const std::vector<BuildListItem *> & builds,
+                  std::vector<BuildListItem *> & plan,
+                  std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    // Installed SlackBuilds that depend on a SlackBuild, directly or not
+
+    void invReqs(const BuildListItem & build,
+                 std::vector<BuildListItem *> & invreqlist,
+                 std::vector<std::vector<BuildListItem> > & slackbuilds);
+
+    // Installed SlackBuilds not required by any other installed SlackBuild
+
+    const std::vector<BuildListItem *> & nondeps(
+                       std::vector<std::vector<BuildListItem> > & slackbuilds);
+};
+
+extern DependencyGraph dependency_graph;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+struct watchevent {
+  std::string path;       // Watched directory
+  std::string name;       // File or directory within path that changed
+  uint32_t mask;          // inotify event mask
+};
+
+/*******************************************************************************
+
+Watches directories for changes using inotify. The file descriptor is
+non-blocking, so it can be polled along with other input and read only when
+events are available.
+
+*******************************************************************************/
+class FileWatcher {
+
+  private:
+
+    int _fd;
+    std::map<int, std::string> _watches;    // Watch descriptor -> path
+
+  public:
+
+    /* Constructor and destructor */
+
+    FileWatcher();
+    ~FileWatcher();
+
+    /* Starts and stops watching. start() returns 0 on success or 1 if inotify
+       is not available. */
+
+    int start();
+    void stop();
+
+    /* Adds a directory to watch. Returns 0 on success or 1 on error. */
+
+    int addWatch(const std::string & path, uint32_t mask);
+
+    /* Reads all pending events without blocking. Returns number of events. */
+
+    unsigned int readEvents(std::vector<watchevent> & events);
+
+    /* Access */
+
+    bool active() const;
+    int fd() const;
+    unsigned int numWatches() const;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <curses.h>
+
+/*******************************************************************************
+
+Batches screen updates. Widgets schedule their windows to be refreshed instead
+of refreshing them right away, and the terminal is updated once, just before
+waiting for the next input event. Repeated resize events that are already
+queued are collapsed into one.
+
+*******************************************************************************/
+class FrameScheduler {
+
+  private:
+
+    bool _pending;
+
+  public:
+
+    /* Constructor */
+
+    FrameScheduler();
+
+    /* Copies window to the virtual screen, to be shown on the next update */
+
+    void schedule(WINDOW *win);
+
+    /* Updates the terminal if anything has been scheduled */
+
+    void update();
+
+    /* Updates the terminal and waits for a key, mouse, or resize event */
+
+    int getInput();
+};
+
+extern FrameScheduler frame_scheduler;
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "BuildListItem.h"
+
+struct fuzzymatch {
+  BuildListItem *build;
+  int score;
+};
+
+/*******************************************************************************
+
+Trigram index of SlackBuild names and short descriptions for fuzzy searching.
+Names and descriptions are stored in lower case along with the sets of
+trigrams they contain, so that a search only has to look at the SlackBuilds
+sharing a trigram with the search term. Matches are ranked: exact, prefix, and
+substring matches of the name come first, then names containing the letters
+of the search term in order (e.g., "ffmpg" for ffmpeg), names within a small
+number of typos, similar names, and finally matches in the description.
+
+*******************************************************************************/
+class FuzzyIndex {
+
+  private:
+
+    std::vector<BuildListItem *> _builds;
+    std::vector<std::string> _names, _squashed, _descs;
+    std::vector<unsigned int> _name_ntrigrams;
+    std::unordered_map<uint32_t, std::vector<unsigned int> > _name_trigrams,
+                                                            _desc_trigrams;
+    bool _ready;
+
+    int scoreName(unsigned int idx, const std::string & term,
+                  const std::string & squashed, unsigned int nshared,
+                  unsigned int ntrigrams) const;
+
+  public:
+
+    /* Constructor */
+
+    FuzzyIndex();
+
+    /* Creating the index. Descriptions are taken from the repository index
+       when it is available. */
+
+    void clear();
+    void create(std::vector<std::vector<BuildListItem> > & slackbuilds);
+    bool ready() const;
+
+    /* Returns matches for a search term, best first */
+
+    void search(const std::string & searchterm,
+                std::vector<fuzzymatch> & matches) const;
+};
@@ -3,6 +3,7 @@
 #include <string>
 #include <curses.h>
 #include "MouseEvent.h"
+#include "damage.h"
 
 /*******************************************************************************
 
@@ -16,7 +17,8 @@ class InputItem {
 
     WINDOW *_win;
     int _posx, _posy, _width; 
-    std::string _name, _redraw_type, _item_type;
+    std::string _name, _item_type;
+    unsigned int _damage;
     bool _selectable, _auto_position;
 
     /* Prints to end of line or specified number of spaces */
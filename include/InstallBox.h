@@ -21,13 +21,35 @@ class InstallBox: public BuildOrderBox {
        for many of the operations. */
 
     std::vector<BuildListItem *> _builds;
-    int _ndeps, _ninvdeps;
+    std::vector<bool> _requested;     // Requested by user, not a dependency
+    std::vector<std::vector<BuildListItem> > *_slackbuilds;
+    int _ndeps, _nrequested, _ninvdeps;
+    mutable int _action_cols;         // Width of action column, with divider
+
+    /* Layout */
+
+    void computeMetrics() const;
+    int dividerColumn() const;
 
     /* Drawing */
     
     void redrawFrame();
     void redrawSingleItem(unsigned int idx);
 
+    /* Sets up list from build order */
+
+    void createFromPlan(const std::vector<BuildListItem *> & plan,
+                        const std::vector<BuildListItem *> & requested,
+                        std::vector<std::vector<BuildListItem> > & slackbuilds,
+                        const std::string & action, bool rebuild_inv_deps);
+
+    /* Applying changes with several builds or downloads at once */
+
+    void prefetchSources();
+    bool buildInParallel() const;
+    int applyChangesParallel(int & ninstalled, int & nupgraded,
+                             int & nreinstalled);
+
   public:
 
     /* Constructors */
@@ -46,12 +68,17 @@ class InstallBox: public BuildOrderBox {
     bool installingAllDeps() const;
     bool installingRequested() const;
 
-    /* Creates list based on SlackBuild selected */
+    /* Creates list based on SlackBuild selected, or on several SlackBuilds
+       with dependencies merged into one build order */
 
     int create(BuildListItem & build,
                std::vector<std::vector<BuildListItem> > & slackbuilds,
                const std::string & action, bool resolve_deps=true,
                bool batch=false, bool rebuild_inv_deps=false);
+    int create(const std::vector<BuildListItem *> & builds,
+               std::vector<std::vector<BuildListItem> > & slackbuilds,
+               const std::string & action, bool resolve_deps=true,
+               bool rebuild_inv_deps=false);
 
     /* Handles mouse event */
 
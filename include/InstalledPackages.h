@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+struct installedpkg {
+  std::string pkg;        // Full package name, e.g. foo-1.0-x86_64-1_SBo
+  std::string name;
+  std::string version;
+  std::string arch;
+  std::string build;
+};
+
+/*******************************************************************************
+
+Database of installed packages, keyed by package base name. The package
+directory is read once with read(), and afterwards update() rechecks a single
+package name after it has been installed, upgraded, reinstalled, or removed, so
+that the whole directory does not need to be scanned again.
+
+*******************************************************************************/
+class InstalledPackages {
+
+  private:
+
+    std::string _package_dir;
+    std::unordered_map<std::string, installedpkg> _packages;
+    std::vector<std::string> _invalid;      // Badly formed package names
+    bool _loaded;
+
+  public:
+
+    /* Constructor */
+
+    InstalledPackages();
+
+    /* Reads the package directory. Returns 0 on success or 1 if it cannot be
+       read. */
+
+    int read(const std::string & package_dir);
+
+    /* Rechecks installed packages with the given name. Returns 0 if the
+       package is installed or 1 if not. */
+
+    int update(const std::string & name);
+
+    /* Access */
+
+    bool loaded() const;
+    unsigned int size() const;
+    const installedpkg * find(const std::string & name) const;
+    std::vector<const installedpkg *> list() const;
+    const std::vector<std::string> & invalid() const;
+};
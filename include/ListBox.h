@@ -38,7 +38,7 @@ class ListBox: public AbstractListBox {
 
     virtual void redrawSingleItem(unsigned int idx);
     virtual void redrawScrollIndicator() const;
-    void redrawChangedItems();
+    virtual void redrawChangedItems();
 
   public:
 
@@ -75,10 +75,6 @@ class ListBox: public AbstractListBox {
 
     virtual std::string handleMouseEvent(MouseEvent * mevent);
 
-    /* Draws frame, items, etc. as needed */
- 
-    virtual void draw(bool force=false);
-
     /* User interaction loop */
 
     virtual std::string exec(MouseEvent * mevent=NULL);
@@ -13,11 +13,16 @@
 #include "SearchBox.h"
 #include "InputBox.h"
 #include "TagList.h"
+#include "InstallBox.h"
 #include "OptionsWindow.h"
 #include "KeyHelpWindow.h"
 #include "MouseHelpWindow.h"
 #include "Menubar.h"
 #include "MouseEvent.h"
+#include "FileWatcher.h"
+#include "FuzzyIndex.h"
+#include "BuildSet.h"
+#include "BuildIndex.h"
 
 /*******************************************************************************
 
@@ -32,9 +37,9 @@ class MainWindow: public CursesWidget {
     CategoryListBox _clistbox;
     std::vector<BuildListBox> _blistboxes;
     std::vector<std::vector<BuildListItem> > _slackbuilds;
-    std::vector<std::vector<BuildListItem *> > _displayed_slackbuilds;
     std::vector<CategoryListItem> _categories;
-    std::vector<CategoryListItem *> _displayed_categories;
+    BuildIndex _build_index;
+    BuildSet _displayed, _filtered;
     FilterBox _fbox;
     SearchBox _searchbox;
     TagList _taglist;
@@ -44,14 +49,20 @@ class MainWindow: public CursesWidget {
     Menubar _menubar;
     std::string _filter, _info, _status, _conf_file;
     unsigned int _category_idx, _activated_listbox;
+    int _screen_rows, _screen_cols;
+    std::string _screen_layout;
+    FileWatcher _watcher;
+    FuzzyIndex _fuzzy_index;
 
+    void redrawStatus(const std::string & msg, bool bold=false);
     void printStatus(const std::string & msg, bool bold=false);
     void clearStatus();
     void refreshStatus();
 
-    void redrawHeaderFooter();
+    void redrawHeaderFooter(bool force=false);
     void redrawWindowsHorz();
     void redrawWindowsVert();
+    void placeWindows();
     void redrawWindows(bool force=false);
     void toggleLayout();
 
@@ -78,6 +89,11 @@ class MainWindow: public CursesWidget {
     void filterBuildOptions();
     void filterSearch(const std::string & searchterm, bool case_sensitive=false,
                       bool whole_whord=false, bool search_readmes=false);
+    void filterFuzzy(const std::string & searchterm);
+    void printSearchResult(unsigned int nsearch,
+                           const std::string & searchterm, bool current_list);
+    void restoreLists(const std::vector<BuildListBox> & blistboxes,
+                      const std::vector<ListItem *> & categories);
 
     /* Displays options window */
 
@@ -94,10 +110,22 @@ class MainWindow: public CursesWidget {
     /* Actions for a selected SlackBuild */
 
     void browseFiles(const BuildListItem & build, MouseEvent * mevent=NULL);
+    int reportPlanProblems(int check, const std::string & what,
+                           MouseEvent * mevent=NULL);
+    std::string describeDeps(int ndeps, unsigned int ninvdeps,
+                             const std::string & action) const;
     bool modifyPackage(BuildListItem & build, const std::string & action,
                        int & ninstalled, int & nupgraded, int & nreinstalled,
                        int & nremoved, bool & cancel_all, bool batch=false,
                        MouseEvent * mevent=NULL);
+    bool modifyPackages(const std::vector<BuildListItem *> & builds,
+                        const std::string & action, int & ninstalled,
+                        int & nupgraded, int & nreinstalled, int & nremoved,
+                        MouseEvent * mevent=NULL);
+    bool confirmAndApply(InstallBox & installer, int & ninstalled,
+                         int & nupgraded, int & nreinstalled, int & nremoved,
+                         bool & cancel_all, bool batch,
+                         MouseEvent * mevent=NULL);
     void setBuildOptions(BuildListItem & build, MouseEvent * mevent=NULL);
     void showBuildOrder(BuildListItem & build,
                         const std::string & mode="forward",
@@ -107,6 +135,13 @@ class MainWindow: public CursesWidget {
     /* Sync/update */
 
     int syncRepo(MouseEvent * mevent=NULL);
+    int updateFromSync(MouseEvent * mevent=NULL);
+
+    /* Watching installed packages and repository for changes */
+
+    void startWatching();
+    void handleWatchEvents();
+    void waitForInput();
 
     /* Apply action to tagged SlackBuilds */
 
@@ -178,6 +213,10 @@ class MainWindow: public CursesWidget {
 
     void quickSearch();
 
+    /* Search that filters the lists as the user types */
+
+    void liveSearch();
+
     /* Upgrade all */
 
     void upgradeAll(MouseEvent * mevent=NULL);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstddef>    // size_t
+
+/*******************************************************************************
+
+Lightweight view of a string owned by someone else (C++11 has no
+std::string_view). Only valid while the owner is alive.
+
+*******************************************************************************/
+struct strview {
+  const char *data;
+  std::size_t size;
+
+  std::string str() const { return std::string(data, size); }
+};
+
+/*******************************************************************************
+
+Variable to be read by MappedShellReader. Set name and default_var; value and
+status are filled in by read().
+
+*******************************************************************************/
+struct shellvar {
+  std::string name;
+  bool default_var;       // Variable is set as ${VAR:-DEFAULT}
+  strview value;
+  int status;             // 0 if read successfully, 1 otherwise
+};
+
+/*******************************************************************************
+
+Reads shell variables from a memory-mapped file. Unlike ShellReader, any number
+of variables are read in a single pass through the file, and values are
+returned as views into the mapping, so that bulk scans of the repository do no
+per-line allocation. Quoting and line continuation are handled the same way as
+in ShellReader.
+
+*******************************************************************************/
+class MappedShellReader {
+
+  private:
+
+    const char *_data;
+    std::size_t _size;
+    bool _file_open;
+
+    // Storage for values spanning multiple lines, which cannot point directly
+    // into the mapping. deque so that existing elements never move.
+
+    std::deque<std::string> _joined;
+
+    // Line handling
+
+    bool nextLine(std::size_t & pos, strview & line) const;
+    bool checkVarname(strview & line, const std::string & varname) const;
+
+    // Reads value of variable starting at the given line
+
+    int readVariable(strview line, std::size_t pos, strview & value);
+    int readDefaultVariable(strview line, strview & value) const;
+
+  public:
+
+    /* Constructor and destructor */
+
+    MappedShellReader();
+    ~MappedShellReader();
+
+    /* Opens or closes a file. Closing invalidates all values read. */
+
+    int open(const std::string & filename);
+    int close();
+
+    /* Reads variables from the file in a single pass */
+
+    int read(std::vector<shellvar> & vars);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*******************************************************************************
+
+Inverted index of the words in SlackBuild README files. Words are runs of
+letters and digits, stored in lower case, each with the list of SlackBuilds
+(category/name) whose README contains it. A search can then look at the
+posting lists instead of reading every README. The index only narrows down
+which READMEs can match; candidates are still checked with find_in_file, so
+results are the same as searching the files directly.
+
+The index is stamped with the git HEAD and modification time of the repository
+and is only used while they match. The modification time of each README is
+also recorded, and READMEs edited since the index was written are always
+candidates.
+
+*******************************************************************************/
+class ReadmeIndex {
+
+  private:
+
+    std::string _repo_dir, _git_head;
+    long long _repo_mtime;
+    std::vector<std::string> _docs;                 // category/name
+    std::vector<long long> _mtimes;                 // Of each README
+    std::unordered_map<std::string, unsigned int> _doc_lookup;
+    std::vector<std::string> _words;                // Sorted
+    std::vector<std::vector<unsigned int> > _postings;
+    std::vector<std::vector<std::string> > _pending;
+    bool _valid;
+
+    void buildLookup();
+    long long readmeMtime(unsigned int doc) const;
+
+  public:
+
+    /* Splitting text into lower case words. readWords() skips comment lines,
+       like find_in_file, and returns 1 if the file cannot be read. */
+
+    static void tokenize(const std::string & text,
+                         std::vector<std::string> & words);
+    static int readWords(const std::string & filename,
+                         std::vector<std::string> & words);
+
+    /* Constructor */
+
+    ReadmeIndex();
+
+    /* Creating the index: add each README's words, then stamp() builds the
+       posting lists */
+
+    void clear();
+    void addReadme(const std::string & category, const std::string & name,
+                   const std::vector<std::string> & words);
+    void stamp(const std::string & repo_dir);
+
+    /* Reading and writing. As with RepoIndex, read() only marks the index
+       valid if it is up to date with repo_dir, unless require_current is
+       false. */
+
+    int read(const std::string & filename, const std::string & repo_dir,
+             bool require_current=true);
+    int write(const std::string & filename) const;
+    bool valid() const;
+
+    /* Words of each README, in the order of documents() */
+
+    const std::vector<std::string> & documents() const;
+    void documentWords(std::vector<std::vector<std::string> > & words) const;
+
+    /* Queries. docId() returns -1 if a SlackBuild is not in the index.
+       docUpToDate() checks whether a README is unchanged since the index was
+       written. candidates() marks the READMEs that may contain pattern; it
+       returns 1 if pattern has no letters or digits, so that the index cannot
+       help. */
+
+    int docId(const std::string & category, const std::string & name) const;
+    bool docUpToDate(unsigned int doc) const;
+    int candidates(const std::string & pattern, bool whole_word,
+                   std::vector<char> & is_candidate) const;
+};
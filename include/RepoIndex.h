@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+struct indexentry {
+  std::string category;
+  std::string name;
+  std::string version;
+  std::string reqs;
+  std::string buildnum;
+  std::string shortdesc;  // From slack-desc
+  int status;             // Return value of get_repo_info when indexed
+  long long mtime;        // From RepoIndex::buildMtime when indexed
+};
+
+struct indexcategory {
+  std::string name;
+  long long mtime;
+  unsigned int first;     // Index of first build in the category
+  unsigned int nbuilds;
+};
+
+/*******************************************************************************
+
+Compact on-disk index of the SlackBuilds repository. Stores category, name,
+VERSION, REQUIRES, BUILD, and short description for every SlackBuild, along
+with a stamp (git HEAD, directory modification times, and the modification
+time of each SlackBuild) used to determine whether the index is still up to
+date with the repository. SlackBuilds edited in place, e.g. in an overlay, are
+caught by the latter even if HEAD and the category directories are unchanged.
+
+*******************************************************************************/
+class RepoIndex {
+
+  private:
+
+    std::string _repo_dir, _git_head;
+    long long _repo_mtime;
+    std::vector<indexcategory> _categories;
+    std::vector<indexentry> _builds;
+    std::unordered_map<std::string, unsigned int> _lookup;
+    bool _valid;
+
+    void buildLookup();
+
+  public:
+
+    /* Stamp helpers */
+
+    static std::string gitHead(const std::string & repo_dir);
+    static long long dirMtime(const std::string & path);
+    static long long buildMtime(const std::string & repo_dir,
+                                const std::string & category,
+                                const std::string & name);
+
+    /* Constructor */
+
+    RepoIndex();
+
+    /* Creating the index */
+
+    void clear();
+    void addBuild(const std::string & category, const std::string & name,
+                  const std::string & version, const std::string & reqs,
+                  const std::string & buildnum,
+                  const std::string & shortdesc, int status);
+    void stamp(const std::string & repo_dir);
+
+    /* Reading and writing. read() only marks the index valid if it is up to
+       date with repo_dir, unless require_current is false (e.g., to reuse
+       unchanged entries after a sync). */
+
+    int read(const std::string & filename, const std::string & repo_dir,
+             bool require_current=true);
+    int write(const std::string & filename) const;
+    bool upToDate(const std::string & repo_dir) const;
+    bool buildUpToDate(const indexentry & entry) const;
+    bool valid() const;
+
+    /* Stops using the index for a SlackBuild that has changed since the
+       index was written, so that it is read from the repository instead */
+
+    void forget(const std::string & category, const std::string & name);
+
+    /* Access */
+
+    unsigned int numCategories() const;
+    const indexcategory & category(unsigned int idx) const;
+    const indexentry & build(unsigned int idx) const;
+    const indexentry * find(const std::string & category,
+                            const std::string & name) const;
+};
@@ -2,27 +2,40 @@
 
 #include <string>
 #include <vector>
+#include <set>
 #include <cmath>   // floor
 #include "BuildListItem.h"
 #include "Blacklist.h"
 #include "IgnoreVersions.h"
+#include "RepoIndex.h"
+#include "ReadmeIndex.h"
+#include "InstalledPackages.h"
 
 extern Blacklist blacklist;
 extern IgnoreVersions ignore_versions;
+extern RepoIndex repo_index;
+extern ReadmeIndex readme_index;
+extern InstalledPackages installed_packages;
+
+int num_jobs();
 
 int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds);
+int update_repo_index(const std::set<std::string> * changed_builds=NULL);
+bool readme_index_ready();
 int read_buildopts(std::vector<std::vector<BuildListItem> > & slackbuilds);
+void index_slackbuilds(const std::vector<std::vector<BuildListItem> > &
+                       slackbuilds);
 int find_slackbuild(const std::string & name,
                     std::vector<std::vector<BuildListItem> > & slackbuilds,
                     int & idx0, int & idx1);
 int get_pkg_info(const std::string & pkg, std::string & name,
                  std::string & version, std::string & arch,
                  std::string & build);
-bool check_installed(const BuildListItem & build, 
-                     const std::vector<std::string> & installedpkgs,
-                     std::string & pkg, std::string & version,
-                     std::string & arch, std::string & pkgbuild);
+bool check_installed(const BuildListItem & build, std::string & pkg,
+                     std::string & version, std::string & arch,
+                     std::string & pkgbuild);
 int get_reqs(const BuildListItem & build, std::string & reqs);
+int get_short_description(const BuildListItem & build, std::string & desc);
 int get_repo_info(const BuildListItem & build, std::string & available_version,
                   std::string & reqs, std::string & available_buildnum);
 void determine_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
@@ -30,8 +43,13 @@ void determine_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
                          std::vector<std::string> & missing_info);
 std::vector<BuildListItem *> list_installed(
                         std::vector<std::vector<BuildListItem> > & slackbuilds);
-std::vector<BuildListItem *> list_nondeps(
-                        std::vector<std::vector<BuildListItem> > & slackbuilds);
+std::string install_command(const BuildListItem & build,
+                            const std::string & action);
+std::string pipeline_command(const BuildListItem & build,
+                             const std::string & action,
+                             const std::string & stage);
+int check_install(BuildListItem & build, const std::string & action,
+                  bool reinstall=true);
 int install_slackbuild(BuildListItem & build);
 int upgrade_slackbuild(BuildListItem & build); 
 int reinstall_slackbuild(BuildListItem & build); 
@@ -40,6 +58,7 @@ int view_readme(const BuildListItem & build);
 int view_file(const std::string & path);
 int view_notes(const BuildListItem & build);
 int sync_repo(bool interactive=true);
+int read_sync_changes(std::vector<std::string> & changed_builds);
 
 /*******************************************************************************
 
@@ -0,0 +1,27 @@
+#pragma once
+
+/*******************************************************************************
+
+Parts of a widget or input item that need to be redrawn. These are bit flags:
+changes add to the damage as they happen, and draw() redraws only the damaged
+parts and then clears the damage. Curses then only sends the cells that
+actually differ to the terminal.
+
+*******************************************************************************/
+enum damage_region {
+  DAMAGE_NONE = 0,
+  DAMAGE_BACKGROUND = 1,  // Clear window and set background color
+  DAMAGE_FRAME = 2,       // Border, title, and header, with buttons
+  DAMAGE_SCROLL = 4,      // Scroll indicator
+  DAMAGE_ITEMS = 8,       // All visible items
+  DAMAGE_ROWS = 16,       // Only items that changed (e.g., highlight moved)
+  DAMAGE_BUTTONS = 32,    // Buttons only
+  DAMAGE_ENTRY = 64,      // Entry of an input item
+  DAMAGE_LABEL = 128,     // Label of an input item
+  DAMAGE_ALL = 255,
+
+  // Highlight moved within the page / page scrolled
+
+  DAMAGE_CHANGED = DAMAGE_SCROLL | DAMAGE_ROWS,
+  DAMAGE_SCROLLED = DAMAGE_SCROLL | DAMAGE_ITEMS
+};
@@ -7,30 +7,47 @@
 #include "CategoryListItem.h"
 #include "CategoryListBox.h"
 #include "BuildListBox.h"
+#include "BuildSet.h"
+#include "BuildIndex.h"
+#include "FuzzyIndex.h"
 
-bool any_build(const BuildListItem & build);
-bool build_is_installed(const BuildListItem & build);
-bool build_is_upgradable(const BuildListItem & build);
-bool build_is_tagged(const BuildListItem & build);
-bool build_is_blacklisted(const BuildListItem & build);
-bool build_has_buildoptions(const BuildListItem & build);
-
-void filter_by_func(std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                    bool (*func)(const BuildListItem &),
-                    std::vector<CategoryListItem *> & categories,
+void filter_by_mask(const BuildIndex & index, const BuildSet & mask,
+                    std::vector<CategoryListItem> & categories,
                     WINDOW *blistboxwin, CategoryListBox & clistbox,
                     std::vector<BuildListBox> & blistboxes,
-                    unsigned int & nfiltered, bool overwrite=true);
+                    unsigned int & nfiltered);
+void filter_by_status(BuildIndex & index, build_status status,
+                      BuildSet & displayed, BuildSet & filtered,
+                      std::vector<CategoryListItem> & categories,
+                      WINDOW *blistboxwin, CategoryListBox & clistbox,
+                      std::vector<BuildListBox> & blistboxes,
+                      unsigned int & nfiltered, bool overwrite=true);
 void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
-                    std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                    std::vector<CategoryListItem *> & categories,
+                    BuildIndex & index, BuildSet & displayed,
+                    BuildSet & filtered,
+                    std::vector<CategoryListItem> & categories,
                     WINDOW *blistboxwin, CategoryListBox & clistbox,
                     std::vector<BuildListBox> & blistboxes,
                     unsigned int & nnondeps, bool overwrite=true);
-void filter_search(std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                   std::vector<CategoryListItem *> & categories,
+void lists_to_set(const BuildIndex & index,
+                  const std::vector<BuildListBox> & blistboxes, BuildSet & set);
+void filter_search(BuildIndex & index, BuildSet & displayed,
+                   BuildSet & filtered,
+                   std::vector<CategoryListItem> & categories,
                    WINDOW *blistboxwin, CategoryListBox & clistbox,
                    std::vector<BuildListBox> & blistboxes,
                    unsigned int & nsearch, const std::string & searchterm,
                    bool case_sensitive, bool whole_word, bool search_readmes,
                    bool overwrite=true);
+void filter_fuzzy(BuildIndex & index, BuildSet & displayed,
+                  BuildSet & filtered,
+                  std::vector<CategoryListItem> & categories,
+                  const FuzzyIndex & fuzzy_index,
+                  WINDOW *blistboxwin, CategoryListBox & clistbox,
+                  std::vector<BuildListBox> & blistboxes,
+                  unsigned int & nsearch, const std::string & searchterm,
+                  bool overwrite=true);
+void refine_search(WINDOW *blistboxwin, CategoryListBox & clistbox,
+                   std::vector<BuildListBox> & blistboxes,
+                   unsigned int & nsearch, const std::string & searchterm,
+                   bool case_sensitive=false);
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <stdint.h>
+
+/* Binary encoding helpers for the index files in /var/lib/sboui/index.
+   Integers are stored in host byte order, since an index is only ever read
+   back on the machine that wrote it. The read functions return 0 on success
+   or 1 if buf ends too soon. */
+
+void write_uint(std::ofstream & file, uint32_t value);
+void write_int64(std::ofstream & file, int64_t value);
+void write_string(std::ofstream & file, const std::string & value);
+int read_uint(const std::string & buf, std::size_t & pos, uint32_t & value);
+int read_int64(const std::string & buf, std::size_t & pos, int64_t & value);
+int read_string(const std::string & buf, std::size_t & pos,
+                std::string & value);
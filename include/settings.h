@@ -21,6 +21,8 @@ namespace settings
   extern std::string layout;
   extern bool resolve_deps, confirm_changes, enable_color, rebuild_inv_deps;
   extern bool save_buildopts, warn_invalid_pkgnames, cumulative_filters;
+  extern bool watch_files, pipeline_builds;
+  extern int jobs, build_jobs, fetch_jobs;
 }
 
 extern Color colors;
@@ -11,6 +11,7 @@ extern std::string trim(const std::string & instr);
 extern std::string remove_leading_whitespace(const std::string & instr);
 extern std::string remove_comment(const std::string & instr,
                                   char comment='#');
+extern std::string shell_quote(const std::string & instr);
 extern std::vector<std::string> split(const std::string & instr,
                                       char delim=' ');
 extern std::vector<std::string> wrap_words(const std::string & instr,
@@ -5,6 +5,7 @@
 #include "Color.h"
 #include "ListItem.h"
 #include "AbstractListBox.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -96,7 +97,7 @@ void AbstractListBox::redrawAllItems()
 
   if (_items.size() == 0)
   {
-    wrefresh(_win);
+    frame_scheduler.schedule(_win);
     return;
   }
   for ( i = _firstprint; i < _firstprint+rowsavail; i++ )
@@ -108,28 +109,85 @@ void AbstractListBox::redrawAllItems()
 
 /*******************************************************************************
 
+Redraws items marked with itemChanged that are on the screen
+
+*******************************************************************************/
+void AbstractListBox::redrawChangedItems()
+{
+  int rows, cols, rowsavail, idx;
+  unsigned int i, nchanged;
+
+  getmaxyx(_win, rows, cols);
+  rowsavail = rows-_reserved_rows;
+
+  nchanged = _changed_items.size();
+  for ( i = 0; i < nchanged; i++ )
+  {
+    idx = _changed_items[i];
+    if ( (idx >= _firstprint) && (idx < _firstprint+rowsavail) &&
+         (idx < int(_items.size())) )
+      redrawSingleItem(idx);
+  }
+}
+
+/*******************************************************************************
+
+Layout metrics. These only depend on the items, so they are computed the first
+time they are needed after the items have changed, instead of every time an
+item is drawn or the size of the box is requested.
+
+*******************************************************************************/
+void AbstractListBox::invalidateMetrics() { _metrics_valid = false; }
+
+void AbstractListBox::checkMetrics() const
+{
+  if (_metrics_valid) { return; }
+  computeMetrics();
+  _metrics_valid = true;
+}
+
+void AbstractListBox::computeMetrics() const
+{
+  int namelen;
+  unsigned int i, nitems;
+
+  _max_name_len = 0;
+  nitems = _items.size();
+  for ( i = 0; i < nitems; i++ )
+  {
+    namelen = _items[i]->name().size();
+    if (namelen > _max_name_len) { _max_name_len = namelen; }
+  }
+}
+
+/*******************************************************************************
+
 Constructors
 
 *******************************************************************************/
 AbstractListBox::AbstractListBox()
 {
   _name = "";
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _items.resize(0);
   _firstprint = 0;
   _header_rows = 3;
   _reserved_rows = 4;   // Assumes no buttons
+  _metrics_valid = false;
+  _max_name_len = 0;
 }
 
 AbstractListBox::AbstractListBox(WINDOW *win, const std::string & name)
 {
   _win = win;
   _name = name;
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _items.resize(0);
   _firstprint = 0;
   _header_rows = 3;
   _reserved_rows = 4;   // Assumes no buttons
+  _metrics_valid = false;
+  _max_name_len = 0;
 }
 
 /*******************************************************************************
@@ -137,19 +195,38 @@ AbstractListBox::AbstractListBox(WINDOW *win, const std::string & name)
 Edit list items
 
 *******************************************************************************/
-void AbstractListBox::addItem(ListItem *item) { _items.push_back(item); }
+void AbstractListBox::addItem(ListItem *item)
+{
+  _items.push_back(item);
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
+}
+
 void AbstractListBox::removeItem(unsigned int idx)
 {
   if (idx <= _items.size()) { _items.erase(_items.begin()+idx); }
   _firstprint = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 void AbstractListBox::clearList()
 {
   _items.resize(0);
   _firstprint = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
+}
+
+/*******************************************************************************
+
+Marks an item to be redrawn on the next draw, e.g. after it was tagged
+
+*******************************************************************************/
+void AbstractListBox::itemChanged(unsigned int idx)
+{
+  _changed_items.push_back(idx);
+  _damage |= DAMAGE_ROWS;
 }
 
 /*******************************************************************************
@@ -157,7 +234,11 @@ void AbstractListBox::clearList()
 Set attributes
 
 *******************************************************************************/
-void AbstractListBox::setName(const std::string & name) { _name = name; }
+void AbstractListBox::setName(const std::string & name)
+{
+  _name = name;
+  _damage |= DAMAGE_ALL;
+}
 
 /*******************************************************************************
 
@@ -170,7 +251,7 @@ unsigned int AbstractListBox::numItems() const { return _items.size(); }
 void AbstractListBox::minimumSize(int & height, int & width) const
 {
   int namelen, reserved_cols;
-  unsigned int i, nitems, nbuttons;
+  unsigned int i, nbuttons;
 
   // Minimum usable height
 
@@ -190,12 +271,8 @@ void AbstractListBox::minimumSize(int & height, int & width) const
     }
     if (namelen > width) { width = namelen; }
   }
-  nitems = _items.size();
-  for ( i = 0; i < nitems; i++ )
-  {
-    namelen = _items[i]->name().size();
-    if (namelen > width) { width = namelen; }
-  }
+  checkMetrics();
+  if (_max_name_len > width) { width = _max_name_len; }
   width += reserved_cols;
 }
 
@@ -224,11 +301,8 @@ void AbstractListBox::preferredSize(int & height, int & width) const
     }
     if (namelen > width) { width = namelen; }
   }
-  for ( i = 0; i < nitems; i++ )
-  {
-    namelen = _items[i]->name().size();
-    if (namelen > width) { width = namelen; }
-  }
+  checkMetrics();
+  if (_max_name_len > width) { width = _max_name_len; }
   width += reserved_cols + widthpadding;
 }
 
@@ -253,23 +327,22 @@ Draws list box (frame, items, etc.) as needed
 *******************************************************************************/
 void AbstractListBox::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _damage = DAMAGE_ALL; }
 
   // Draw list elements
 
-  if (_redraw_type == "all")
+  if (_damage & DAMAGE_BACKGROUND)
   { 
     clearWindow();
     colors.setBackground(_win, _fg_color, _bg_color);
   }
-  if (_redraw_type == "buttons") { redrawButtons(); }
-  else if (_redraw_type != "none")
-  {
-    redrawFrame();
-    redrawScrollIndicator();
-  }
-  if ( (_redraw_type == "all") || (_redraw_type == "items")) { 
-                                                            redrawAllItems(); }
-  wrefresh(_win);
+  if (_damage & DAMAGE_FRAME) { redrawFrame(); }
+  else if (_damage & DAMAGE_BUTTONS) { redrawButtons(); }
+  if (_damage & DAMAGE_SCROLL) { redrawScrollIndicator(); }
+  if (_damage & DAMAGE_ITEMS) { redrawAllItems(); }
+  else if (_damage & DAMAGE_ROWS) { redrawChangedItems(); }
+  _damage = DAMAGE_NONE;
+  _changed_items.resize(0);
+  frame_scheduler.schedule(_win);
 }
 
@@ -0,0 +1,147 @@
+#include <vector>
+#include <unordered_map>
+#include "BuildListItem.h"
+#include "BuildSet.h"
+#include "BuildIndex.h"
+
+/*******************************************************************************
+
+Constructor and clearing
+
+*******************************************************************************/
+BuildIndex::BuildIndex() { clear(); }
+
+void BuildIndex::clear()
+{
+  unsigned int k;
+
+  _builds.clear();
+  _categories.clear();
+  _first.assign(1, 0);
+  _lookup.clear();
+  for ( k = 0; k < NUM_STATUSES; k++ ) { _status[k].resize(0); }
+  _dirty = true;
+}
+
+/*******************************************************************************
+
+Numbers all SlackBuilds in the repository. Statuses start out empty.
+
+*******************************************************************************/
+void BuildIndex::create(std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, j, k, nbuilds, ncategories;
+
+  clear();
+
+  ncategories = slackbuilds.size();
+  _categories.resize(ncategories);
+  _first.resize(ncategories+1);
+  for ( i = 0; i < ncategories; i++ )
+  {
+    _first[i] = _builds.size();
+    nbuilds = slackbuilds[i].size();
+    _categories[i].resize(nbuilds);
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      _categories[i][j] = &slackbuilds[i][j];
+      _builds.push_back(&slackbuilds[i][j]);
+    }
+  }
+  _first[ncategories] = _builds.size();
+
+  nbuilds = _builds.size();
+  _lookup.reserve(nbuilds);
+  for ( i = 0; i < nbuilds; i++ ) { _lookup[_builds[i]] = i; }
+  for ( k = 0; k < NUM_STATUSES; k++ ) { _status[k].resize(nbuilds); }
+  _dirty = true;
+}
+
+/*******************************************************************************
+
+Updating statuses
+
+*******************************************************************************/
+void BuildIndex::readStatus(unsigned int idx)
+{
+  const BuildListItem *build;
+
+  build = _builds[idx];
+  _status[STATUS_INSTALLED].set(idx, build->installed());
+  _status[STATUS_UPGRADABLE].set(idx, build->upgradable());
+  _status[STATUS_TAGGED].set(idx, build->tagged());
+  _status[STATUS_BLACKLISTED].set(idx, build->blacklisted());
+  _status[STATUS_BUILDOPTIONS].set(idx, build->buildOptions() != "");
+}
+
+void BuildIndex::update(const BuildListItem * build)
+{
+  int idx;
+
+  idx = indexOf(build);
+  if (idx != -1) { readStatus(idx); }
+}
+
+void BuildIndex::invalidate() { _dirty = true; }
+
+void BuildIndex::refresh()
+{
+  unsigned int i, nbuilds;
+
+  if (! _dirty) { return; }
+
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ ) { readStatus(i); }
+  _dirty = false;
+}
+
+void BuildIndex::setNonDeps(const std::vector<BuildListItem *> & nondeps)
+{
+  unsigned int k, nnondeps;
+  int idx;
+
+  _status[STATUS_NONDEP].fill(false);
+  nnondeps = nondeps.size();
+  for ( k = 0; k < nnondeps; k++ )
+  {
+    idx = indexOf(nondeps[k]);
+    if (idx != -1) { _status[STATUS_NONDEP].set(idx); }
+  }
+}
+
+const BuildSet & BuildIndex::status(build_status which) const
+{
+  return _status[which];
+}
+
+/*******************************************************************************
+
+Access
+
+*******************************************************************************/
+unsigned int BuildIndex::size() const { return _builds.size(); }
+unsigned int BuildIndex::numCategories() const { return _categories.size(); }
+unsigned int BuildIndex::first(unsigned int category) const
+{
+  return _first[category];
+}
+
+const std::vector<BuildListItem *> &
+BuildIndex::categoryBuilds(unsigned int category) const
+{
+  return _categories[category];
+}
+
+BuildListItem * BuildIndex::build(unsigned int idx) const
+{
+  return _builds[idx];
+}
+
+int BuildIndex::indexOf(const BuildListItem * build) const
+{
+  std::unordered_map<const BuildListItem *, unsigned int>::const_iterator it;
+
+  it = _lookup.find(build);
+  if (it == _lookup.end()) { return -1; }
+  return it->second;
+}
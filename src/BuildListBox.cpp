@@ -8,6 +8,7 @@
 #include "TagList.h"
 #include "BuildListItem.h"
 #include "BuildListBox.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -192,6 +193,9 @@ BuildListBox::BuildListBox()
   _reserved_rows = 4; 
   _header_rows = 3;
   _taglist = NULL;
+  _source = NULL;
+  _mask = NULL;
+  _first = 0;
 }
 BuildListBox::BuildListBox(WINDOW *win, const std::string & name)
 {
@@ -200,6 +204,143 @@ BuildListBox::BuildListBox(WINDOW *win, const std::string & name)
   _reserved_rows = 4;
   _header_rows = 3;
   _taglist = NULL;
+  _source = NULL;
+  _mask = NULL;
+  _first = 0;
+}
+
+/*******************************************************************************
+
+Lazy filling from the SlackBuilds of a category
+
+*******************************************************************************/
+void BuildListBox::setSource(const std::vector<BuildListItem *> *source,
+                             const BuildSet *mask, unsigned int first)
+{
+  ListBox::clearList();
+  _source = source;
+  _mask = mask;
+  _first = first;
+}
+
+bool BuildListBox::pending() const { return (_source != NULL); }
+
+void BuildListBox::materialize()
+{
+  unsigned int i, nbuilds;
+
+  if (_source == NULL) { return; }
+  nbuilds = _source->size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if ( (_mask == NULL) || (_mask->test(_first+i)) )
+      _items.push_back((*_source)[i]);
+  }
+  invalidateMetrics();
+  _source = NULL;
+  _mask = NULL;
+  _first = 0;
+}
+
+/*******************************************************************************
+
+Gets the items in the list, without filling it if it is still pending
+
+*******************************************************************************/
+void BuildListBox::filteredItems(std::vector<BuildListItem *> & items) const
+{
+  unsigned int i, nbuilds;
+
+  if (_source == NULL)
+  {
+    items.resize(_items.size());
+    for ( i = 0; i < _items.size(); i++ )
+    {
+      items[i] = static_cast<BuildListItem *>(_items[i]);
+    }
+    return;
+  }
+
+  items.resize(0);
+  nbuilds = _source->size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if ( (_mask == NULL) || (_mask->test(_first+i)) )
+      items.push_back((*_source)[i]);
+  }
+}
+
+/*******************************************************************************
+
+Edit list
+
+*******************************************************************************/
+void BuildListBox::addItem(ListItem *item)
+{
+  materialize();
+  ListBox::addItem(item);
+}
+
+void BuildListBox::removeItem(unsigned int idx)
+{
+  materialize();
+  ListBox::removeItem(idx);
+}
+
+void BuildListBox::clearList()
+{
+  _source = NULL;
+  _mask = NULL;
+  _first = 0;
+  ListBox::clearList();
+}
+
+/*******************************************************************************
+
+Set and get attributes and items
+
+*******************************************************************************/
+int BuildListBox::setHighlight(int highlight)
+{
+  materialize();
+  return ListBox::setHighlight(highlight);
+}
+
+int BuildListBox::setHighlight(const std::string & name)
+{
+  materialize();
+  return ListBox::setHighlight(name);
+}
+
+unsigned int BuildListBox::numItems() const
+{
+  if (_source == NULL) { return _items.size(); }
+  if (_mask == NULL) { return _source->size(); }
+  return _mask->count(_first, _first + _source->size());
+}
+
+const std::string & BuildListBox::highlightedName()
+{
+  materialize();
+  return ListBox::highlightedName();
+}
+
+int BuildListBox::highlightSearch(const std::string & pattern)
+{
+  materialize();
+  return ListBox::highlightSearch(pattern);
+}
+
+ListItem * BuildListBox::highlightedItem()
+{
+  materialize();
+  return ListBox::highlightedItem();
+}
+
+ListItem * BuildListBox::itemByIdx(unsigned int idx)
+{
+  materialize();
+  return ListBox::itemByIdx(idx);
 }
 
 /*******************************************************************************
@@ -212,8 +353,23 @@ bool BuildListBox::allTagged() const
   unsigned int i, nitems;
   bool all_tagged;
 
-  nitems = _items.size();
   all_tagged = true;
+  if (_source != NULL)
+  {
+    nitems = _source->size();
+    for ( i = 0; i < nitems; i++ )
+    {
+      if ( (_mask != NULL) && (! _mask->test(_first+i)) ) { continue; }
+      if (! (*_source)[i]->getBoolProp("tagged"))
+      {
+        all_tagged = false;
+        break;
+      }
+    }
+    return all_tagged;
+  }
+
+  nitems = _items.size();
   for ( i = 0; i < nitems; i++ )
   {
     if (! _items[i]->getBoolProp("tagged")) 
@@ -240,11 +396,13 @@ Tags or untags a single item
 *******************************************************************************/
 void BuildListBox::tagSlackBuild(unsigned int idx)
 {
+  materialize();
   if (idx < numItems())
   {
     _items[idx]->setBoolProp("tagged", ! _items[idx]->getBoolProp("tagged"));
     if (_items[idx]->getBoolProp("tagged")) { _taglist->addItem(_items[idx]); }
     else { _taglist->removeItem(_items[idx]); }
+    itemChanged(idx);
   }
 }
 void BuildListBox::tagHighlightedSlackBuild() { tagSlackBuild(_highlight); }
@@ -261,6 +419,7 @@ unsigned int BuildListBox::tagAll()
 
   // First check if everything is tagged
 
+  materialize();
   nitems = _items.size();
   if (! allTagged())
   {
@@ -289,13 +448,30 @@ unsigned int BuildListBox::tagAll()
 
   // Set all items to be redrawn
 
-  _redraw_type = "items";
+  _damage |= DAMAGE_ITEMS;
 
   return retval;
 }
 
 /*******************************************************************************
 
+Drawing and handling mouse events, after filling the list if needed
+
+*******************************************************************************/
+void BuildListBox::draw(bool force)
+{
+  materialize();
+  ListBox::draw(force);
+}
+
+std::string BuildListBox::handleMouseEvent(MouseEvent * mevent)
+{
+  materialize();
+  return ListBox::handleMouseEvent(mevent);
+}
+
+/*******************************************************************************
+
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
@@ -310,6 +486,7 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
   // Highlight first entry on first display
 
+  materialize();
   if ( (_highlight == 0) && (_prevhighlight == 0) ) { highlightFirst(); }
 
   // Draw list elements
@@ -318,14 +495,14 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: accept selection
 
     case '\n':
     case '\r':
     case KEY_ENTER:
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       if (int(_button_signals.size()) >= _highlighted_button+1)
         retval = _button_signals[_highlighted_button];
       else
@@ -336,7 +513,7 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
@@ -344,38 +521,38 @@ std::string BuildListBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::highlight;
       check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_DOWN:
       retval = signals::highlight;
       check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_PPAGE:
       retval = signals::highlight;
       check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_NPAGE:
       retval = signals::highlight;
       check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     // Right and left keys: change highlighted button (if present)
@@ -383,46 +560,46 @@ std::string BuildListBox::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      _redraw_type = "changed";
+      _damage |= DAMAGE_BUTTONS;
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      _redraw_type = "changed";
+      _damage |= DAMAGE_BUTTONS;
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // t and T: tag item
 
     case 't':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     case 'T':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // F9 key: activates menubar
 
     case KEY_F(9):
       retval = signals::keyF9;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Mouse
@@ -431,7 +608,7 @@ std::string BuildListBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
         retval = signals::mouseEvent;
       }
       else
@@ -440,7 +617,6 @@ std::string BuildListBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
       break;
   }
   return retval;
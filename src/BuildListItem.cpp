@@ -2,11 +2,50 @@
 #include <vector>
 #include <algorithm> 	// count
 #include <cctype>	// isdigit
+#include <unordered_map>
+#include <unordered_set>
 #include "backend.h"
 #include "string_util.h"
 #include "ListItem.h"
 #include "BuildListItem.h"
 
+// Typed fields, as looked up by the generic prop methods
+
+enum { FIELD_NONE = -1, FIELD_INSTALLED, FIELD_UPGRADABLE, FIELD_TAGGED,
+       FIELD_BLACKLISTED, FIELD_MARKED, FIELD_ACTION, FIELD_CATEGORY,
+       FIELD_INSTALLED_VERSION, FIELD_AVAILABLE_VERSION,
+       FIELD_INSTALLED_BUILDNUM, FIELD_AVAILABLE_BUILDNUM, FIELD_REQUIRES,
+       FIELD_PACKAGE_NAME, FIELD_BUILD_OPTIONS };
+
+static const std::string empty_string = "";
+static const std::string true_string = "true";
+static const std::string false_string = "false";
+static const std::string action_names[] = { "", "Install", "Upgrade",
+                                            "Reinstall", "Remove",
+                                            "(blacklisted)" };
+
+/*******************************************************************************
+
+Returns a pointer to a shared copy of a string. Many SlackBuilds have the same
+category, version, or build number, so each distinct value is only stored once.
+Interned strings are never freed.
+
+*******************************************************************************/
+static const std::string * intern(const std::string & value)
+{
+  static std::unordered_set<std::string> pool;
+  const std::string *interned;
+
+  if (value.empty()) { return &empty_string; }
+
+  // Items may be set up from parallel loops while reading the repository
+
+#pragma omp critical(intern_string)
+  { interned = &(*pool.insert(value).first); }
+
+  return interned;
+}
+
 /*******************************************************************************
 
 Checks if installed version is the same as available version, but with a kernel
@@ -57,36 +96,28 @@ bool BuildListItem::differsByKernel(const std::string & installed_version,
 Checks whether SlackBuild can be upgraded
 
 *******************************************************************************/
-bool BuildListItem::upgradable() const
+bool BuildListItem::checkUpgradable() const
 {
   bool test_version, test_buildnum;
-  std::string installed_version, available_version;
-  std::string installed_buildnum, available_buildnum;
-
-  test_version = false;
-  installed_version = getProp("installed_version");
-  available_version = getProp("available_version");
-
-  test_buildnum = false;
-  installed_buildnum = getProp("installed_buildnum");
-  available_buildnum = getProp("available_buildnum");
 
   // Check if new VERSION or BUILD is available
 
-  if ( (getBoolProp("installed")) && (! getBoolProp("blacklisted")) )
+  test_version = false;
+  test_buildnum = false;
+  if ( installed() && (! blacklisted()) )
   {
-    if (installed_version != available_version)
+    if (*_installed_version != *_available_version)
     {
-      if (! differsByKernel(installed_version, available_version))
+      if (! differsByKernel(*_installed_version, *_available_version))
         test_version = true;
     }
-    if (installed_buildnum != available_buildnum)
+    if (*_installed_buildnum != *_available_buildnum)
       test_buildnum = true;
   }
 
   // Check if available version is listed in the ignore_version file.
   // We'll still let it be upgradable if the build number is different.
-  if (_ignore_versions->ignoreVersion(_name, available_version))
+  if (_ignore_versions->ignoreVersion(_name, *_available_version))
   {
     test_version = false;
   }
@@ -96,29 +127,77 @@ bool BuildListItem::upgradable() const
 
 /*******************************************************************************
 
+Maps a prop name to the corresponding typed field, or FIELD_NONE if it is not
+one of the SlackBuild props
+
+*******************************************************************************/
+int BuildListItem::fieldByName(const std::string & propname)
+{
+  static const std::unordered_map<std::string, int> fields = {
+    {"installed", FIELD_INSTALLED},
+    {"upgradable", FIELD_UPGRADABLE},
+    {"tagged", FIELD_TAGGED},
+    {"blacklisted", FIELD_BLACKLISTED},
+    {"marked", FIELD_MARKED},
+    {"action", FIELD_ACTION},
+    {"category", FIELD_CATEGORY},
+    {"installed_version", FIELD_INSTALLED_VERSION},
+    {"available_version", FIELD_AVAILABLE_VERSION},
+    {"installed_buildnum", FIELD_INSTALLED_BUILDNUM},
+    {"available_buildnum", FIELD_AVAILABLE_BUILDNUM},
+    {"requires", FIELD_REQUIRES},
+    {"package_name", FIELD_PACKAGE_NAME},
+    {"build_options", FIELD_BUILD_OPTIONS}
+  };
+  std::unordered_map<std::string, int>::const_iterator it;
+
+  it = fields.find(propname);
+  if (it == fields.end()) { return FIELD_NONE; }
+  else { return it->second; }
+}
+
+/*******************************************************************************
+
+Returns the bit flag for a bool field, or 0 if the field is not a bool
+
+*******************************************************************************/
+unsigned int BuildListItem::flagByField(int field) const
+{
+  switch (field) {
+    case FIELD_INSTALLED:
+      return INSTALLED;
+    case FIELD_UPGRADABLE:
+      return UPGRADABLE;
+    case FIELD_TAGGED:
+      return TAGGED;
+    case FIELD_BLACKLISTED:
+      return BLACKLISTED;
+    case FIELD_MARKED:
+      return MARKED;
+    default:
+      return 0;
+  }
+}
+
+/*******************************************************************************
+
 Constructor
 
 *******************************************************************************/
 BuildListItem::BuildListItem() 
 { 
   _name = ""; 
-
-  // Add props in reverse alphabetical order (should be fastest)
-
-  addBoolProp("upgradable", false);
-  addBoolProp("tagged", false);
-  addProp("requires", "");
-  addProp("package_name", "");
-  addBoolProp("marked", false);
-  addProp("installed_version", "");
-  addProp("installed_buildnum", "");
-  addBoolProp("installed", false);
-  addProp("category", "");
-  addProp("build_options", "");
-  addBoolProp("blacklisted", false);
-  addProp("available_version", "");
-  addProp("available_buildnum", "");
-  addProp("action", "");
+  _flags = 0;
+  _action = ACTION_NONE;
+  _category = &empty_string;
+  _installed_version = &empty_string;
+  _available_version = &empty_string;
+  _installed_buildnum = &empty_string;
+  _available_buildnum = &empty_string;
+  _requires = "";
+  _package_name = "";
+  _build_options = "";
+  _ignore_versions = NULL;
 }
 
 /*******************************************************************************
@@ -133,33 +212,309 @@ void BuildListItem::setIgnoreVersions(IgnoreVersions * ignore_versions)
 
 /*******************************************************************************
 
+Generic prop methods. SlackBuild props are routed to the typed fields, and any
+other props are handled by ListItem. Bools are converted to and from "true" and
+"false" as in ListItem.
+
+*******************************************************************************/
+void BuildListItem::addProp(const std::string & propname,
+                            const std::string & value)
+{
+  if (fieldByName(propname) == FIELD_NONE)
+    ListItem::addProp(propname, value);
+  else
+    setProp(propname, value);
+}
+
+void BuildListItem::addBoolProp(const std::string & propname, bool value)
+{
+  if (fieldByName(propname) == FIELD_NONE)
+    ListItem::addBoolProp(propname, value);
+  else
+    setBoolProp(propname, value);
+}
+
+int BuildListItem::setProp(const std::string & propname,
+                           const std::string & value)
+{
+  int field;
+  unsigned int flag;
+
+  field = fieldByName(propname);
+  flag = flagByField(field);
+  if (flag != 0)
+  {
+    if (string2Bool(value)) { _flags |= flag; }
+    else { _flags &= ~flag; }
+    return 0;
+  }
+
+  switch (field) {
+    case FIELD_ACTION:
+      setAction(actionByName(value));
+      break;
+    case FIELD_CATEGORY:
+      setCategory(value);
+      break;
+    case FIELD_INSTALLED_VERSION:
+      setInstalledVersion(value);
+      break;
+    case FIELD_AVAILABLE_VERSION:
+      setAvailableVersion(value);
+      break;
+    case FIELD_INSTALLED_BUILDNUM:
+      setInstalledBuildNum(value);
+      break;
+    case FIELD_AVAILABLE_BUILDNUM:
+      setAvailableBuildNum(value);
+      break;
+    case FIELD_REQUIRES:
+      setReqs(value);
+      break;
+    case FIELD_PACKAGE_NAME:
+      setPackageName(value);
+      break;
+    case FIELD_BUILD_OPTIONS:
+      setBuildOptions(value);
+      break;
+    default:
+      return ListItem::setProp(propname, value);
+  }
+
+  return 0;
+}
+
+int BuildListItem::setBoolProp(const std::string & propname, bool value)
+{
+  int field;
+  unsigned int flag;
+
+  field = fieldByName(propname);
+  if (field == FIELD_NONE) { return ListItem::setBoolProp(propname, value); }
+
+  flag = flagByField(field);
+  if (flag != 0)
+  {
+    if (value) { _flags |= flag; }
+    else { _flags &= ~flag; }
+    return 0;
+  }
+  else { return setProp(propname, bool2String(value)); }
+}
+
+bool BuildListItem::checkProp(const std::string & propname) const
+{
+  if (fieldByName(propname) != FIELD_NONE) { return true; }
+  else { return ListItem::checkProp(propname); }
+}
+
+const std::string & BuildListItem::getProp(const std::string & propname) const
+{
+  int field;
+  unsigned int flag;
+
+  field = fieldByName(propname);
+  flag = flagByField(field);
+  if (flag != 0)
+  {
+    if (_flags & flag) { return true_string; }
+    else { return false_string; }
+  }
+
+  switch (field) {
+    case FIELD_ACTION:
+      return actionName(_action);
+    case FIELD_CATEGORY:
+      return *_category;
+    case FIELD_INSTALLED_VERSION:
+      return *_installed_version;
+    case FIELD_AVAILABLE_VERSION:
+      return *_available_version;
+    case FIELD_INSTALLED_BUILDNUM:
+      return *_installed_buildnum;
+    case FIELD_AVAILABLE_BUILDNUM:
+      return *_available_buildnum;
+    case FIELD_REQUIRES:
+      return _requires;
+    case FIELD_PACKAGE_NAME:
+      return _package_name;
+    case FIELD_BUILD_OPTIONS:
+      return _build_options;
+    default:
+      return ListItem::getProp(propname);
+  }
+}
+
+bool BuildListItem::getBoolProp(const std::string & propname) const
+{
+  int field;
+  unsigned int flag;
+
+  field = fieldByName(propname);
+  if (field == FIELD_NONE) { return ListItem::getBoolProp(propname); }
+
+  flag = flagByField(field);
+  if (flag != 0) { return (_flags & flag) != 0; }
+  else { return string2Bool(getProp(propname)); }
+}
+
+/*******************************************************************************
+
+Typed access to bool props
+
+*******************************************************************************/
+bool BuildListItem::installed() const { return (_flags & INSTALLED) != 0; }
+bool BuildListItem::upgradable() const { return (_flags & UPGRADABLE) != 0; }
+bool BuildListItem::tagged() const { return (_flags & TAGGED) != 0; }
+bool BuildListItem::blacklisted() const { return (_flags & BLACKLISTED) != 0; }
+bool BuildListItem::marked() const { return (_flags & MARKED) != 0; }
+
+void BuildListItem::setInstalled(bool installed)
+{
+  if (installed) { _flags |= INSTALLED; }
+  else { _flags &= ~INSTALLED; }
+}
+
+void BuildListItem::setUpgradable(bool upgradable)
+{
+  if (upgradable) { _flags |= UPGRADABLE; }
+  else { _flags &= ~UPGRADABLE; }
+}
+
+void BuildListItem::setTagged(bool tagged)
+{
+  if (tagged) { _flags |= TAGGED; }
+  else { _flags &= ~TAGGED; }
+}
+
+void BuildListItem::setBlacklisted(bool blacklisted)
+{
+  if (blacklisted) { _flags |= BLACKLISTED; }
+  else { _flags &= ~BLACKLISTED; }
+}
+
+void BuildListItem::setMarked(bool marked)
+{
+  if (marked) { _flags |= MARKED; }
+  else { _flags &= ~MARKED; }
+}
+
+/*******************************************************************************
+
+Typed access to action. actionName gives the text displayed in the InstallBox,
+and actionByName converts it back. Unrecognized names map to ACTION_NONE.
+
+*******************************************************************************/
+const std::string & BuildListItem::actionName(build_action action)
+{
+  return action_names[action];
+}
+
+build_action BuildListItem::actionByName(const std::string & name)
+{
+  if (name == "Install") { return ACTION_INSTALL; }
+  else if (name == "Upgrade") { return ACTION_UPGRADE; }
+  else if (name == "Reinstall") { return ACTION_REINSTALL; }
+  else if (name == "Remove") { return ACTION_REMOVE; }
+  else if (name == "(blacklisted)") { return ACTION_BLACKLISTED; }
+  else { return ACTION_NONE; }
+}
+
+build_action BuildListItem::action() const { return _action; }
+void BuildListItem::setAction(build_action action) { _action = action; }
+
+/*******************************************************************************
+
+Typed access to string props
+
+*******************************************************************************/
+const std::string & BuildListItem::category() const { return *_category; }
+const std::string & BuildListItem::installedVersion() const
+{
+  return *_installed_version;
+}
+const std::string & BuildListItem::availableVersion() const
+{
+  return *_available_version;
+}
+const std::string & BuildListItem::installedBuildNum() const
+{
+  return *_installed_buildnum;
+}
+const std::string & BuildListItem::availableBuildNum() const
+{
+  return *_available_buildnum;
+}
+const std::string & BuildListItem::reqs() const { return _requires; }
+const std::string & BuildListItem::packageName() const { return _package_name; }
+const std::string & BuildListItem::buildOptions() const
+{
+  return _build_options;
+}
+
+void BuildListItem::setCategory(const std::string & category)
+{
+  _category = intern(category);
+}
+
+void BuildListItem::setInstalledVersion(const std::string & version)
+{
+  _installed_version = intern(version);
+}
+
+void BuildListItem::setAvailableVersion(const std::string & version)
+{
+  _available_version = intern(version);
+}
+
+void BuildListItem::setInstalledBuildNum(const std::string & buildnum)
+{
+  _installed_buildnum = intern(buildnum);
+}
+
+void BuildListItem::setAvailableBuildNum(const std::string & buildnum)
+{
+  _available_buildnum = intern(buildnum);
+}
+
+void BuildListItem::setReqs(const std::string & reqs) { _requires = reqs; }
+void BuildListItem::setPackageName(const std::string & package_name)
+{
+  _package_name = package_name;
+}
+void BuildListItem::setBuildOptions(const std::string & build_options)
+{
+  _build_options = build_options;
+}
+
+/*******************************************************************************
+
 Checks whether this BuildListItem is installed and gets information about it
 if so. If repo info has been read already, checks whether installed SlackBuild
 is also upgradable.
 
 *******************************************************************************/
-void BuildListItem::readInstalledProps(std::vector<std::string> & installedpkgs)
+void BuildListItem::readInstalledProps()
 {
   std::string pkg, version, arch, build;
 
-  if (check_installed(*this, installedpkgs, pkg, version, arch, build))
+  if (check_installed(*this, pkg, version, arch, build))
   {
-    setBoolProp("installed", true);
-    setProp("installed_version", version);
-    setProp("package_name", pkg);
-    setBoolProp("blacklisted", blacklist.blacklisted(pkg, _name, 
-                               version, arch, build));
+    setInstalled(true);
+    setInstalledVersion(version);
+    setPackageName(pkg);
+    setBlacklisted(blacklist.blacklisted(pkg, _name, version, arch, build));
     parseBuildNum(build);
-    if (getProp("available_version") != "")
-      setBoolProp("upgradable", upgradable());
+    if (! _available_version->empty())
+      setUpgradable(checkUpgradable());
   }
   else
   {
-    setBoolProp("installed", false);
-    setProp("installed_version", "");
-    setProp("package_name", "");
-    setBoolProp("blacklisted", blacklist.nameBlacklisted(_name));
-    setBoolProp("upgradable", false);
+    setInstalled(false);
+    setInstalledVersion("");
+    setPackageName("");
+    setBlacklisted(blacklist.nameBlacklisted(_name));
+    setUpgradable(false);
   }
 }
 
@@ -176,13 +531,10 @@ int BuildListItem::readPropsFromRepo()
   check = get_repo_info(*this, available_version, reqs, available_buildnum);
   if (check == 0)
   {
-    setProp("available_version", available_version);
-    setProp("requires", reqs);
-    setProp("available_buildnum", available_buildnum);
-    if (getBoolProp("installed"))
-    {
-      setBoolProp("upgradable", upgradable());
-    }
+    setAvailableVersion(available_version);
+    setReqs(reqs);
+    setAvailableBuildNum(available_buildnum);
+    if (installed()) { setUpgradable(checkUpgradable()); }
   }
 
   return check;
@@ -194,7 +546,7 @@ Determines BUILD number from last portion of package name and sets it in
 installed_buildnum prop
 
 *******************************************************************************/
-void BuildListItem::parseBuildNum(std::string & build)
+void BuildListItem::parseBuildNum(const std::string & build)
 {
   int i, buildlen;
   std::string buildnum;
@@ -210,7 +562,7 @@ void BuildListItem::parseBuildNum(std::string & build)
   }
   if (buildnum.length() == 0) { buildnum = '0'; }
       
-  setProp("installed_buildnum", buildnum);
+  setInstalledBuildNum(buildnum);
 }
 
 /*******************************************************************************
@@ -224,7 +576,7 @@ std::string BuildListItem::buildOptionsEnv() const
   std::vector<std::string> build_options;
   std::string build_options_string;
 
-  build_options = split(getProp("build_options"), ';');
+  build_options = split(_build_options, ';');
   build_options_string = "";
   noptions = build_options.size();
   for ( i = 0; i < noptions-1; i++ )
@@ -192,11 +192,11 @@ void BuildOptionsBox::draw(bool force)
   int rows, cols;
   unsigned int i, nitems;
 
-  if (force) { _redraw_type = "all"; }
+  if (force) { _damage = DAMAGE_ALL; }
 
   // Set width of everything
 
-  if (_redraw_type == "all")
+  if (_damage & DAMAGE_BACKGROUND)
   {
     determineFirstPrint();
     getmaxyx(_win, rows, cols);
@@ -227,7 +227,7 @@ std::string BuildOptionsBox::exec(MouseEvent * mevent)
     // Draw input box elements
   
     draw();
-    _redraw_type = "changed";
+    _damage |= DAMAGE_CHANGED;
     y_offset = _firstprint - _header_rows;
 
     // Get user input from highlighted item
@@ -246,7 +246,7 @@ std::string BuildOptionsBox::exec(MouseEvent * mevent)
       else if (_items[_highlight]->name() == "- Remove last (press space)")
         removeLast();
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       getting_input = false;
     }
   }
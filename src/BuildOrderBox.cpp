@@ -7,7 +7,7 @@
 #include "settings.h"
 #include "signals.h"
 #include "MouseEvent.h"
-#include "requirements.h"
+#include "DependencyGraph.h"
 #include "BuildListItem.h"
 #include "BuildOrderBox.h"
 
@@ -229,11 +229,10 @@ Get attributes
 void BuildOrderBox::minimumSize(int & height, int & width) const
 {
   int namelen, reserved_cols, installed_cols;
-  unsigned int i, nitems, nbuttons;
+  unsigned int i, nbuttons;
 
   // Minimum usable height
 
-  nitems = _items.size();
   height = _reserved_rows + 2;
 
   // Minimum usable width
@@ -251,11 +250,9 @@ void BuildOrderBox::minimumSize(int & height, int & width) const
     }
     if (namelen > width) { width = namelen; }
   }
-  for ( i = 0; i < nitems; i++ )
-  {
-    namelen = _items[i]->name().size() + installed_cols;
-    if (namelen > width) { width = namelen; }
-  }
+  checkMetrics();
+  namelen = _max_name_len + installed_cols;
+  if (namelen > width) { width = namelen; }
   width += reserved_cols;
 }
 
@@ -297,13 +294,13 @@ int BuildOrderBox::create(BuildListItem & build,
   if (mode == "forward")
   {
     setName(build.name() + " build order");
-    check = compute_reqs_order(build, reqlist, slackbuilds);
+    check = dependency_graph.reqsOrder(build, reqlist, slackbuilds);
     reqlist.push_back(&build);
   }
   else if (mode == "inverse")
   {
     setName(build.name() + " inverse deps");
-    compute_inv_reqs(build, reqlist, slackbuilds);
+    dependency_graph.invReqs(build, reqlist, slackbuilds);
   }
   else
     return 2;
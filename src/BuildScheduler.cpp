@@ -0,0 +1,244 @@
+#include <string>
+#include <vector>
+#include <cstdlib>          // setenv
+#include <fcntl.h>          // open
+#include <unistd.h>         // fork, dup2, execl, _exit
+#include <sys/types.h>
+#include <sys/wait.h>       // waitpid
+#include "BuildScheduler.h"
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+BuildScheduler::BuildScheduler()
+{
+  _jobs.resize(0);
+  _max_jobs.assign(1, 1);
+  _nrunning_class.assign(1, 0);
+  _nrunning = 0;
+}
+
+/*******************************************************************************
+
+Setting up. addJob returns the index of the new job. Prerequisites must be
+indices of jobs that were already added. Classes that have not been given a
+limit run one job at a time.
+
+*******************************************************************************/
+void BuildScheduler::setMaxJobs(unsigned int max_jobs, unsigned int jobclass)
+{
+  if (jobclass >= _max_jobs.size())
+  {
+    _max_jobs.resize(jobclass+1, 1);
+    _nrunning_class.resize(jobclass+1, 0);
+  }
+  if (max_jobs < 1) { _max_jobs[jobclass] = 1; }
+  else { _max_jobs[jobclass] = max_jobs; }
+}
+
+int BuildScheduler::addJob(const std::string & cmd, const std::string & log,
+                           const std::vector<int> & prereqs,
+                           unsigned int jobclass)
+{
+  buildjob job;
+
+  if (jobclass >= _max_jobs.size())
+  {
+    _max_jobs.resize(jobclass+1, 1);
+    _nrunning_class.resize(jobclass+1, 0);
+  }
+
+  job.cmd = cmd;
+  job.log = log;
+  job.prereqs = prereqs;
+  job.jobclass = jobclass;
+  job.state = JOB_WAITING;
+  job.status = 0;
+  job.pid = -1;
+  _jobs.push_back(job);
+
+  return _jobs.size()-1;
+}
+
+/*******************************************************************************
+
+Starts a job in a child process. Returns 0 on success or 1 if the process
+could not be created.
+
+*******************************************************************************/
+int BuildScheduler::startJob(int idx)
+{
+  pid_t pid;
+  int fd;
+
+  pid = fork();
+  if (pid == -1) { return 1; }
+  if (pid == 0)
+  {
+    // Child: redirect input and output, then run the command. The backend
+    // uses SBOUI_PARALLEL to keep its files apart from other jobs.
+
+    fd = open("/dev/null", O_RDONLY);
+    if (fd != -1) { dup2(fd, STDIN_FILENO); close(fd); }
+    fd = open(_jobs[idx].log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd != -1)
+    {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+    setenv("SBOUI_PARALLEL", "1", 1);
+    execl("/bin/sh", "sh", "-c", _jobs[idx].cmd.c_str(), (char *) NULL);
+    _exit(127);
+  }
+
+  _jobs[idx].pid = pid;
+  _jobs[idx].state = JOB_RUNNING;
+  _nrunning_class[_jobs[idx].jobclass]++;
+  _nrunning++;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Starts waiting jobs whose prerequisites are done, up to the maximum number of
+jobs in each class. Jobs with a failed or skipped prerequisite are skipped. If
+nothing is running and nothing can be started, the remaining jobs can never run
+(e.g., because of circular prerequisites), so they are skipped too. Returns
+number of jobs started.
+
+*******************************************************************************/
+unsigned int BuildScheduler::startReady()
+{
+  unsigned int i, k, njobs, nstarted;
+  bool ready, changed;
+  int prereq;
+
+  njobs = _jobs.size();
+  nstarted = 0;
+  changed = true;
+  while (changed)
+  {
+    changed = false;
+    for ( i = 0; i < njobs; i++ )
+    {
+      if (_jobs[i].state != JOB_WAITING) { continue; }
+
+      ready = true;
+      for ( k = 0; k < _jobs[i].prereqs.size(); k++ )
+      {
+        prereq = _jobs[i].prereqs[k];
+        if ( (_jobs[prereq].state == JOB_FAILED) ||
+             (_jobs[prereq].state == JOB_SKIPPED) )
+        {
+          _jobs[i].state = JOB_SKIPPED;
+          changed = true;
+          break;
+        }
+        else if (_jobs[prereq].state != JOB_DONE) { ready = false; }
+      }
+      if ( (_jobs[i].state != JOB_WAITING) || (! ready) ) { continue; }
+      if (_nrunning_class[_jobs[i].jobclass] >= _max_jobs[_jobs[i].jobclass])
+        continue;
+
+      if (startJob(i) == 0) { nstarted++; }
+      else
+      {
+        _jobs[i].state = JOB_FAILED;
+        _jobs[i].status = -1;
+        changed = true;
+      }
+    }
+  }
+
+  if ( (_nrunning == 0) && (nstarted == 0) )
+  {
+    for ( i = 0; i < njobs; i++ )
+    {
+      if (_jobs[i].state == JOB_WAITING) { _jobs[i].state = JOB_SKIPPED; }
+    }
+  }
+
+  return nstarted;
+}
+
+/*******************************************************************************
+
+Waits for a running job to finish and sets idx to its index. Returns 0, or 1
+if no job is running.
+
+*******************************************************************************/
+int BuildScheduler::waitJob(int & idx)
+{
+  unsigned int i, njobs;
+  pid_t pid;
+  int status;
+
+  if (_nrunning == 0) { return 1; }
+
+  njobs = _jobs.size();
+  while (true)
+  {
+    pid = waitpid(-1, &status, 0);
+    if (pid == -1) { return 1; }
+    for ( i = 0; i < njobs; i++ )
+    {
+      if ( (_jobs[i].state == JOB_RUNNING) && (_jobs[i].pid == pid) )
+      {
+        // See `man waitpid` for more info on WEXITSTATUS and WIFEXITED
+
+        if (WIFEXITED(status)) { _jobs[i].status = WEXITSTATUS(status); }
+        else { _jobs[i].status = -1; }
+        if (_jobs[i].status == 0) { _jobs[i].state = JOB_DONE; }
+        else { _jobs[i].state = JOB_FAILED; }
+        _jobs[i].pid = -1;
+        _nrunning_class[_jobs[i].jobclass]--;
+        _nrunning--;
+        idx = i;
+        return 0;
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+
+Marks a finished job as failed, e.g. when its command succeeded but the result
+is not what was expected. Jobs that depend on it will be skipped.
+
+*******************************************************************************/
+void BuildScheduler::markFailed(int idx)
+{
+  if (_jobs[idx].state == JOB_DONE) { _jobs[idx].state = JOB_FAILED; }
+}
+
+/*******************************************************************************
+
+Checks whether all jobs have finished, failed, or been skipped
+
+*******************************************************************************/
+bool BuildScheduler::finished() const
+{
+  unsigned int i, njobs;
+
+  njobs = _jobs.size();
+  for ( i = 0; i < njobs; i++ )
+  {
+    if ( (_jobs[i].state == JOB_WAITING) || (_jobs[i].state == JOB_RUNNING) )
+      return false;
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+
+Access
+
+*******************************************************************************/
+unsigned int BuildScheduler::numJobs() const { return _jobs.size(); }
+unsigned int BuildScheduler::numRunning() const { return _nrunning; }
+const buildjob & BuildScheduler::job(int idx) const { return _jobs[idx]; }
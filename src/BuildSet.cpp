@@ -0,0 +1,176 @@
+#include <vector>
+#include <algorithm>    // min
+#include <stdint.h>
+#include "BuildSet.h"
+
+/*******************************************************************************
+
+Mask of the bits below bit i of a word, i.e. 2^i - 1
+
+*******************************************************************************/
+static uint64_t low_bits(unsigned int i)
+{
+  if (i >= 64) { return ~uint64_t(0); }
+  return (uint64_t(1) << i) - 1;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+BuildSet::BuildSet() { _size = 0; }
+
+/*******************************************************************************
+
+Keeps the unused bits of the last word clear, so that counts are right
+
+*******************************************************************************/
+void BuildSet::clearTail()
+{
+  if ( (_size % 64) != 0 ) { _words.back() &= low_bits(_size % 64); }
+}
+
+/*******************************************************************************
+
+Size and setting all bits at once
+
+*******************************************************************************/
+void BuildSet::resize(unsigned int size, bool value)
+{
+  _size = size;
+  _words.resize((size+63)/64);
+  fill(value);
+}
+
+unsigned int BuildSet::size() const { return _size; }
+
+void BuildSet::fill(bool value)
+{
+  if (value) { _words.assign(_words.size(), ~uint64_t(0)); }
+  else { _words.assign(_words.size(), 0); }
+  clearTail();
+}
+
+/*******************************************************************************
+
+Single bits
+
+*******************************************************************************/
+void BuildSet::set(unsigned int idx, bool value)
+{
+  if (idx >= _size) { return; }
+  if (value) { _words[idx/64] |= uint64_t(1) << (idx % 64); }
+  else { _words[idx/64] &= ~(uint64_t(1) << (idx % 64)); }
+}
+
+bool BuildSet::test(unsigned int idx) const
+{
+  if (idx >= _size) { return false; }
+  return ( (_words[idx/64] >> (idx % 64)) & 1 ) != 0;
+}
+
+/*******************************************************************************
+
+Combining with another set. Sizes are expected to be the same; extra words of
+the other set are ignored.
+
+*******************************************************************************/
+BuildSet & BuildSet::operator &= (const BuildSet & other)
+{
+  unsigned int i, nwords;
+
+  nwords = _words.size();
+  for ( i = 0; i < nwords; i++ )
+  {
+    if (i < other._words.size()) { _words[i] &= other._words[i]; }
+    else { _words[i] = 0; }
+  }
+
+  return *this;
+}
+
+BuildSet & BuildSet::operator |= (const BuildSet & other)
+{
+  unsigned int i, nwords;
+
+  nwords = std::min(_words.size(), other._words.size());
+  for ( i = 0; i < nwords; i++ ) { _words[i] |= other._words[i]; }
+  clearTail();
+
+  return *this;
+}
+
+BuildSet & BuildSet::subtract(const BuildSet & other)
+{
+  unsigned int i, nwords;
+
+  nwords = std::min(_words.size(), other._words.size());
+  for ( i = 0; i < nwords; i++ ) { _words[i] &= ~other._words[i]; }
+
+  return *this;
+}
+
+/*******************************************************************************
+
+Number of bits set
+
+*******************************************************************************/
+unsigned int BuildSet::count() const
+{
+  unsigned int i, nwords, nset;
+
+  nset = 0;
+  nwords = _words.size();
+  for ( i = 0; i < nwords; i++ ) { nset += __builtin_popcountll(_words[i]); }
+
+  return nset;
+}
+
+unsigned int BuildSet::count(unsigned int first, unsigned int last) const
+{
+  unsigned int i, firstword, lastword, nset;
+
+  if (last > _size) { last = _size; }
+  if (first >= last) { return 0; }
+
+  firstword = first/64;
+  lastword = (last-1)/64;
+  if (firstword == lastword)
+    return __builtin_popcountll(_words[firstword] & ~low_bits(first % 64) &
+                                low_bits(last - 64*lastword));
+
+  nset = __builtin_popcountll(_words[firstword] & ~low_bits(first % 64));
+  for ( i = firstword+1; i < lastword; i++ )
+  {
+    nset += __builtin_popcountll(_words[i]);
+  }
+  nset += __builtin_popcountll(_words[lastword] & low_bits(last - 64*lastword));
+
+  return nset;
+}
+
+/*******************************************************************************
+
+Finds the next bit set, skipping empty words
+
+*******************************************************************************/
+unsigned int BuildSet::next(unsigned int idx) const
+{
+  unsigned int i, nwords;
+  uint64_t word;
+
+  if (idx >= _size) { return _size; }
+
+  i = idx/64;
+  word = _words[i] & ~low_bits(idx % 64);
+  nwords = _words.size();
+  while (word == 0)
+  {
+    i++;
+    if (i >= nwords) { return _size; }
+    word = _words[i];
+  }
+
+  return 64*i + __builtin_ctzll(word);
+}
@@ -7,6 +7,7 @@
 #include "BuildListItem.h"
 #include "BuildListBox.h"
 #include "CategoryListBox.h"
+#include "FrameScheduler.h"
 
 
 /*******************************************************************************
@@ -173,6 +174,7 @@ void CategoryListBox::tagCategory(unsigned int idx)
   {
     _items[idx]->setBoolProp("tagged", 
                              (! _items[idx]->getBoolProp("tagged")));
+    itemChanged(idx);
   }
 }
 void CategoryListBox::tagHighlightedCategory() { tagCategory(_highlight); }
@@ -203,7 +205,7 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: accept selection
 
@@ -211,25 +213,25 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
     case '\r':
     case KEY_ENTER:
       retval = signals::keyEnter;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Tab key: return keyTab
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Left/right arrows
 
     case KEY_LEFT:
       retval = signals::keyLeft;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
     case KEY_RIGHT:
       retval = signals::keyRight;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
@@ -237,71 +239,71 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::highlight;
       check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_DOWN:
       retval = signals::highlight;
       check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_PPAGE:
       retval = signals::highlight;
       check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_NPAGE:
       retval = signals::highlight;
       check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // t or T: tag item
 
     case 't':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     case 'T':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // F9 key: activates menubar
 
     case KEY_F(9):
       retval = signals::keyF9;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Mouse
@@ -310,7 +312,7 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
         retval = signals::mouseEvent;
       }
       else
@@ -319,7 +321,6 @@ std::string CategoryListBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
       break;
   }
   return retval;
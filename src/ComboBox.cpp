@@ -9,6 +9,7 @@
 #include "InputBox.h"
 #include "ComboBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -60,7 +61,7 @@ std::string ComboBox::execList(int y_offset, MouseEvent * mevent)
   top = std::floor(double(rows)/2.);
   mvwin(_listwin, top, left);
   wresize(_listwin, 0, 0);
-  wrefresh(_listwin);
+  frame_scheduler.schedule(_listwin);
   _parent->draw(true);
 
   return retval;
@@ -74,7 +75,7 @@ Constructor and destructor
 ComboBox::ComboBox()
 { 
   _parent = NULL;
-  _redraw_type = "box"; _item_type = "ComboBox";
+  _damage = DAMAGE_ALL; _item_type = "ComboBox";
   _selectable = true;
   _listwin = newwin(1, 1, 0, 0); 
   _list.setWindow(_listwin);
@@ -83,7 +84,7 @@ ComboBox::ComboBox()
 ComboBox::ComboBox(InputBox *parent)
 { 
   _parent = parent;
-  _redraw_type = "box"; _item_type = "ComboBox";
+  _damage = DAMAGE_ALL; _item_type = "ComboBox";
   _selectable = true;
   _listwin = newwin(1, 1, 0, 0); 
   _list.setWindow(_listwin);
@@ -181,7 +182,7 @@ void ComboBox::draw(int y_offset, bool force, bool highlight)
   {
     if (highlight) { wattroff(_win, A_REVERSE); }
   }
-  wrefresh(_win);
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -209,7 +210,7 @@ std::string ComboBox::exec(int y_offset, MouseEvent * mevent)
     
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
 
       // Enter key: return Enter signal
 
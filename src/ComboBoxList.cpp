@@ -8,6 +8,7 @@
 #include "ListItem.h"
 #include "ComboBoxList.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -117,7 +118,8 @@ void ComboBoxList::clearList()
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 /*******************************************************************************
@@ -127,8 +129,8 @@ Get attributes
 *******************************************************************************/
 void ComboBoxList::preferredSize(int & height, int & width) const
 {
-  int namelen, reserved_cols;
-  unsigned int i, nitems;
+  int reserved_cols;
+  unsigned int nitems;
 
   // Minimum usable height
 
@@ -137,14 +139,9 @@ void ComboBoxList::preferredSize(int & height, int & width) const
 
   // Minimum usable width
 
-  width = 0;
+  checkMetrics();
   reserved_cols = 4;      // For indicator on right
-  for ( i = 0; i < nitems; i++ )
-  {
-    namelen = _items[i]->name().size();
-    if (namelen > width) { width = namelen; }
-  }
-  width += reserved_cols;
+  width = _max_name_len + reserved_cols;
 }
 
 /*******************************************************************************
@@ -154,20 +151,21 @@ Draws box (frame, items, etc.) as needed
 *******************************************************************************/
 void ComboBoxList::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _damage = DAMAGE_ALL; }
 
   // Draw list elements
 
-  if (_redraw_type == "all")
+  if (_damage & DAMAGE_BACKGROUND)
   {
     clearWindow();
     colors.setBackground(_win, "fg_combobox", "bg_combobox");
   }
-  if (_redraw_type != "none") { redrawFrame(); }
-  if ( (_redraw_type == "all") || (_redraw_type == "items") ) {
-                                                            redrawAllItems(); }
-  else if (_redraw_type == "changed") { redrawChangedItems(); }
-  wrefresh(_win);
+  if (_damage & DAMAGE_FRAME) { redrawFrame(); }
+  if (_damage & DAMAGE_ITEMS) { redrawAllItems(); }
+  else if (_damage & DAMAGE_ROWS) { redrawChangedItems(); }
+  _damage = DAMAGE_NONE;
+  _changed_items.resize(0);
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -186,8 +184,9 @@ std::string ComboBoxList::handleMouseEvent(MouseEvent * mevent)
   {
     // Redraw and pause for .1 seconds to make button selection visible
 
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
     draw();
+    frame_scheduler.update();
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     retval = signals::keyEnter;
   }
@@ -172,7 +172,7 @@ CursesWidget::CursesWidget()
   _fg_color = "fg_normal";
   _bg_color = "bg_normal";
   _highlighted_button = 0;
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
 }
 
 /*******************************************************************************
@@ -0,0 +1,481 @@
+#include <string>
+#include <vector>
+#include <algorithm>       // max, copy, reverse
+#include "BuildListItem.h"
+#include "backend.h"       // get_reqs, find_slackbuild, num_jobs
+#include "string_util.h"   // split
+#include "DependencyGraph.h"
+
+DependencyGraph dependency_graph;
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+DependencyGraph::DependencyGraph()
+{
+  _slackbuilds = NULL;
+  _nondeps_valid = false;
+  _mark_gen = 0;
+}
+
+/*******************************************************************************
+
+Builds the graph from a list of SlackBuilds, with requirements taken from the
+repository. The list should already be indexed with index_slackbuilds, and it
+must not be resized or reordered while the graph is in use.
+
+*******************************************************************************/
+void DependencyGraph::create(std::vector<std::vector<BuildListItem> > &
+                             slackbuilds)
+{
+  unsigned int i, j, k, ncategories, nnodes, ndeps;
+  std::vector<std::vector<int> > deps;
+  std::vector<std::string> deplist;
+  std::vector<int> last_dependent;
+  std::vector<unsigned int> fill;
+  std::string reqs;
+  int idx0, idx1, dep;
+
+  clear();
+
+  // Assign IDs category by category
+
+  ncategories = slackbuilds.size();
+  _category_offset.resize(ncategories);
+  nnodes = 0;
+  for ( i = 0; i < ncategories; i++ )
+  {
+    _category_offset[i] = nnodes;
+    nnodes += slackbuilds[i].size();
+  }
+  _nodes.resize(nnodes);
+  for ( i = 0; i < ncategories; i++ )
+  {
+    for ( j = 0; j < slackbuilds[i].size(); j++ )
+    {
+      _nodes[_category_offset[i]+j] = &slackbuilds[i][j];
+    }
+  }
+
+  // Look up requirements of each node in parallel. They are read from the
+  // repository even for installed SlackBuilds, so that the graph does not
+  // depend on what is installed.
+
+  deps.resize(nnodes);
+  _info_missing.assign(nnodes, 0);
+  _missing_dep.assign(nnodes, 0);
+#pragma omp parallel for schedule(dynamic) private(k,ndeps,deplist,reqs,idx0,\
+                                                   idx1) num_threads(num_jobs())
+  for ( i = 0; i < nnodes; i++ )
+  {
+    if (get_reqs(*_nodes[i], reqs) == 0) { deplist = split(reqs); }
+    else
+    {
+      _info_missing[i] = 1;
+      continue;
+    }
+
+    ndeps = deplist.size();
+    for ( k = 0; k < ndeps; k++ )
+    {
+      if (deplist[k] == "%README%") { continue; }
+      if (find_slackbuild(deplist[k], slackbuilds, idx0, idx1) == 0)
+      {
+        deps[i].push_back(_category_offset[idx0]+idx1);
+      }
+      else { _missing_dep[i] = 1; }
+    }
+  }
+
+  // Pack into adjacency arrays
+
+  _adj_start.resize(nnodes+1);
+  _adj_start[0] = 0;
+  for ( i = 0; i < nnodes; i++ )
+  {
+    _adj_start[i+1] = _adj_start[i] + deps[i].size();
+  }
+  _adj.resize(_adj_start[nnodes]);
+  for ( i = 0; i < nnodes; i++ )
+  {
+    std::copy(deps[i].begin(), deps[i].end(), _adj.begin()+_adj_start[i]);
+  }
+
+  // Reverse adjacency arrays. Dependents are listed once each, in ID order.
+
+  _rev_start.assign(nnodes+1, 0);
+  last_dependent.assign(nnodes, -1);
+  for ( i = 0; i < nnodes; i++ )
+  {
+    for ( k = _adj_start[i]; k < _adj_start[i+1]; k++ )
+    {
+      dep = _adj[k];
+      if (last_dependent[dep] == int(i)) { continue; }
+      last_dependent[dep] = i;
+      _rev_start[dep+1]++;
+    }
+  }
+  for ( i = 0; i < nnodes; i++ ) { _rev_start[i+1] += _rev_start[i]; }
+  _rev.resize(_rev_start[nnodes]);
+  fill.assign(_rev_start.begin(), _rev_start.end()-1);
+  last_dependent.assign(nnodes, -1);
+  for ( i = 0; i < nnodes; i++ )
+  {
+    for ( k = _adj_start[i]; k < _adj_start[i+1]; k++ )
+    {
+      dep = _adj[k];
+      if (last_dependent[dep] == int(i)) { continue; }
+      last_dependent[dep] = i;
+      _rev[fill[dep]] = i;
+      fill[dep]++;
+    }
+  }
+
+  _closure.resize(nnodes);
+  _inv_closure.resize(nnodes);
+  _closure_check.assign(nnodes, 0);
+  _mark.assign(nnodes, 0);
+  _slackbuilds = &slackbuilds;
+  installedChanged();
+}
+
+/*******************************************************************************
+
+Clears the graph. It will be rebuilt on the next query.
+
+*******************************************************************************/
+void DependencyGraph::clear()
+{
+  _slackbuilds = NULL;
+  _nodes.resize(0);
+  _category_offset.resize(0);
+  _adj_start.resize(0);
+  _adj.resize(0);
+  _rev_start.resize(0);
+  _rev.resize(0);
+  _info_missing.resize(0);
+  _missing_dep.resize(0);
+  _closure.resize(0);
+  _inv_closure.resize(0);
+  _closure_check.resize(0);
+  _closure_state.resize(0);
+  _inv_state.resize(0);
+  _nondeps.resize(0);
+  _nondeps_valid = false;
+  _mark.resize(0);
+  _mark_gen = 0;
+}
+
+/*******************************************************************************
+
+Forgets remembered answers after SlackBuilds have been installed or removed.
+The adjacency arrays are kept.
+
+*******************************************************************************/
+void DependencyGraph::installedChanged()
+{
+  _closure_state.assign(_nodes.size(), 0);
+  _inv_state.assign(_nodes.size(), 0);
+  _nondeps.resize(0);
+  _nondeps_valid = false;
+}
+
+/*******************************************************************************
+
+Checks whether the graph was built from the given list
+
+*******************************************************************************/
+bool DependencyGraph::builtFor(const std::vector<std::vector<BuildListItem> > &
+                               slackbuilds) const
+{
+  return (_slackbuilds == &slackbuilds);
+}
+
+/*******************************************************************************
+
+Computes the requirements of a node in build order and remembers them. The order
+is that of a depth-first search through REQUIRES, reversed, where a SlackBuild
+reached more than once counts only at its last visit. Keeping the last visit
+commutes with concatenation, so the closure of a node can be put together from
+the closures of its direct requirements.
+
+*******************************************************************************/
+void DependencyGraph::computeClosure(int node)
+{
+  unsigned int i, k, nclosure;
+  std::vector<int> seq;
+  std::vector<int> & closure = _closure[node];
+  int dep, check;
+
+  _closure_state[node] = 1;
+  if ( (_info_missing[node]) && (! _nodes[node]->installed()) ) { check = 2; }
+  else if (_missing_dep[node]) { check = 1; }
+  else { check = 0; }
+
+  // Make sure closures of the requirements are done first. A requirement that
+  // is still being computed is part of a cycle; it is listed, but its own
+  // requirements are not followed again.
+
+  for ( i = _adj_start[node]; i < _adj_start[node+1]; i++ )
+  {
+    dep = _adj[i];
+    if (_closure_state[dep] == 0) { computeClosure(dep); }
+  }
+
+  // Search sequence: each requirement followed by its closure (in reverse
+  // build order). Only the last occurrence of each SlackBuild counts.
+
+  for ( i = _adj_start[node]; i < _adj_start[node+1]; i++ )
+  {
+    dep = _adj[i];
+    seq.push_back(dep);
+    if (_closure_state[dep] == 2)
+    {
+      nclosure = _closure[dep].size();
+      for ( k = nclosure; k > 0; k-- ) { seq.push_back(_closure[dep][k-1]); }
+      check = std::max(check, _closure_check[dep]);
+    }
+  }
+
+  keepLastOccurrences(seq, node, closure);
+  _closure_check[node] = check;
+  _closure_state[node] = 2;
+}
+
+/*******************************************************************************
+
+Computes the installed SlackBuilds that depend on a node and remembers them.
+The order is that of a depth-first search through installed dependents in ID
+order, where a SlackBuild reached more than once counts only at its last visit.
+
+*******************************************************************************/
+void DependencyGraph::computeInvClosure(int node)
+{
+  unsigned int i, k, nclosure;
+  std::vector<int> seq;
+  std::vector<int> & closure = _inv_closure[node];
+  int dep;
+
+  _inv_state[node] = 1;
+
+  for ( i = _rev_start[node]; i < _rev_start[node+1]; i++ )
+  {
+    dep = _rev[i];
+    if ( (_nodes[dep]->installed()) && (_inv_state[dep] == 0) )
+      computeInvClosure(dep);
+  }
+
+  for ( i = _rev_start[node]; i < _rev_start[node+1]; i++ )
+  {
+    dep = _rev[i];
+    if (! _nodes[dep]->installed()) { continue; }
+    seq.push_back(dep);
+    if (_inv_state[dep] == 2)
+    {
+      nclosure = _inv_closure[dep].size();
+      for ( k = 0; k < nclosure; k++ ) { seq.push_back(_inv_closure[dep][k]); }
+    }
+  }
+
+  keepLastOccurrences(seq, node, closure);
+  std::reverse(closure.begin(), closure.end());
+  _inv_state[node] = 2;
+}
+
+/*******************************************************************************
+
+Keeps the last occurrence of each node in a sequence, leaving out the given
+node. The result is in reverse order of the last occurrences.
+
+*******************************************************************************/
+void DependencyGraph::keepLastOccurrences(const std::vector<int> & seq,
+                                          int node, std::vector<int> & list)
+{
+  unsigned int k;
+  int item;
+
+  _mark_gen++;
+  list.resize(0);
+  for ( k = seq.size(); k > 0; k-- )
+  {
+    item = seq[k-1];
+    if ( (_mark[item] == _mark_gen) || (item == node) ) { continue; }
+    _mark[item] = _mark_gen;
+    list.push_back(item);
+  }
+}
+
+/*******************************************************************************
+
+Node IDs
+
+*******************************************************************************/
+int DependencyGraph::id(const BuildListItem & build) const
+{
+  int idx0, idx1;
+
+  if (_slackbuilds == NULL) { return -1; }
+  if (find_slackbuild(build.name(),
+                      const_cast<std::vector<std::vector<BuildListItem> > &>(
+                      *_slackbuilds), idx0, idx1) != 0) { return -1; }
+
+  return _category_offset[idx0] + idx1;
+}
+
+/*******************************************************************************
+
+Gets requirements of a SlackBuild in build order. The graph is built first if
+it was not built from slackbuilds. Returns 1 if a requirement is not found in
+the repository, 2 if a .info file is missing, or 0 otherwise.
+
+*******************************************************************************/
+int DependencyGraph::reqsOrder(const BuildListItem & build,
+                               std::vector<BuildListItem *> & reqlist,
+                    std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, nreqs;
+  int node;
+
+  reqlist.resize(0);
+  if (! builtFor(slackbuilds)) { create(slackbuilds); }
+  node = id(build);
+  if (node < 0) { return 2; }
+
+  if (_closure_state[node] != 2) { computeClosure(node); }
+
+  nreqs = _closure[node].size();
+  reqlist.resize(nreqs);
+  for ( i = 0; i < nreqs; i++ ) { reqlist[i] = _nodes[_closure[node][i]]; }
+
+  return _closure_check[node];
+}
+
+/*******************************************************************************
+
+Gets a merged build order for several SlackBuilds, as if each were installed
+in turn with its requirements, but listing each SlackBuild only the first time
+it is needed. Since each closure is already in build order, this is still a
+valid build order. Returns 1 if a requirement is not found in the repository,
+2 if a .info file is missing, or 0 otherwise.
+
+*******************************************************************************/
+int DependencyGraph::planOrder(const std::vector<BuildListItem *> & builds,
+                               std::vector<BuildListItem *> & plan,
+                       std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, k, nbuilds, nreqs;
+  int node, req, check;
+
+  plan.resize(0);
+  if (! builtFor(slackbuilds)) { create(slackbuilds); }
+
+  // Compute closures first, since that uses the marks too
+
+  check = 0;
+  nbuilds = builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    node = id(*builds[i]);
+    if (node < 0) { check = 2; }
+    else
+    {
+      if (_closure_state[node] != 2) { computeClosure(node); }
+      check = std::max(check, _closure_check[node]);
+    }
+  }
+
+  _mark_gen++;
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    node = id(*builds[i]);
+    if (node < 0)
+    {
+      plan.push_back(builds[i]);
+      continue;
+    }
+
+    nreqs = _closure[node].size();
+    for ( k = 0; k < nreqs; k++ )
+    {
+      req = _closure[node][k];
+      if (_mark[req] == _mark_gen) { continue; }
+      _mark[req] = _mark_gen;
+      plan.push_back(_nodes[req]);
+    }
+    if (_mark[node] != _mark_gen)
+    {
+      _mark[node] = _mark_gen;
+      plan.push_back(builds[i]);
+    }
+  }
+
+  return check;
+}
+
+/*******************************************************************************
+
+Gets installed SlackBuilds that depend on a SlackBuild, directly or through
+other installed SlackBuilds. The graph is built first if it was not built from
+slackbuilds.
+
+*******************************************************************************/
+void DependencyGraph::invReqs(const BuildListItem & build,
+                              std::vector<BuildListItem *> & invreqlist,
+                       std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, nreqs;
+  int node;
+
+  invreqlist.resize(0);
+  if (! builtFor(slackbuilds)) { create(slackbuilds); }
+  node = id(build);
+  if (node < 0) { return; }
+
+  if (_inv_state[node] != 2) { computeInvClosure(node); }
+
+  nreqs = _inv_closure[node].size();
+  invreqlist.resize(nreqs);
+  for ( i = 0; i < nreqs; i++ )
+  {
+    invreqlist[i] = _nodes[_inv_closure[node][i]];
+  }
+}
+
+/*******************************************************************************
+
+Gets installed SlackBuilds that are not required by any other installed
+SlackBuild, in ID order. The graph is built first if it was not built from
+slackbuilds. The list is remembered until installedChanged() is called.
+
+*******************************************************************************/
+const std::vector<BuildListItem *> & DependencyGraph::nondeps(
+                        std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, k, nnodes;
+  bool isdep;
+
+  if (! builtFor(slackbuilds)) { create(slackbuilds); }
+  if (_nondeps_valid) { return _nondeps; }
+
+  _nondeps.resize(0);
+  nnodes = _nodes.size();
+  for ( i = 0; i < nnodes; i++ )
+  {
+    if (! _nodes[i]->installed()) { continue; }
+    isdep = false;
+    for ( k = _rev_start[i]; k < _rev_start[i+1]; k++ )
+    {
+      if ( (_rev[k] != int(i)) && (_nodes[_rev[k]]->installed()) )
+      {
+        isdep = true;
+        break;
+      }
+    }
+    if (! isdep) { _nondeps.push_back(_nodes[i]); }
+  }
+  _nondeps_valid = true;
+
+  return _nondeps;
+}
@@ -9,6 +9,7 @@
 #include "SelectionBox.h"
 #include "DirListBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
  
@@ -240,7 +241,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
   
     // Get user input
   
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
   
       // Enter key: accept selection
   
@@ -249,7 +250,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
       case KEY_ENTER:
         if (_highlighted_button == 0)
         {
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           if (_items[_highlight]->getProp("type") == "dir")
           {
             if (_items[_highlight]->name() == "..") { navigateUp(); }
@@ -264,7 +265,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
         else
         {
           retval = signals::quit;
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           getting_input = false;
         }
         break;
@@ -273,53 +274,51 @@ std::string DirListBox::exec(MouseEvent * mevent)
   
       case KEY_UP:
         check_redraw = highlightPrevious();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_DOWN:
         check_redraw = highlightNext();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_PPAGE:
         check_redraw = highlightPreviousPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_NPAGE:
         check_redraw = highlightNextPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_HOME:
         check_redraw = highlightFirst();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_END:
         check_redraw = highlightLast();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
 
       // Right/Left: change higlighted button
 
       case KEY_RIGHT:
         check_redraw = highlightNextButton();
-        if (check_redraw == 1) { _redraw_type = "buttons"; }
-        else { _redraw_type = "none"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
         break;
       case KEY_LEFT:
         check_redraw = highlightPreviousButton();
-        if (check_redraw == 1) { _redraw_type = "buttons"; }
-        else { _redraw_type = "none"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
         break;
   
       // Resize signal
   
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "all";
+        _damage |= DAMAGE_ALL;
         getting_input = false;
         break;
   
@@ -327,7 +326,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
   
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "all";
+        _damage |= DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -340,7 +339,7 @@ std::string DirListBox::exec(MouseEvent * mevent)
           retval = handleMouseEvent(mevent);
           if (retval == signals::keyEnter)
           {
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
             if (_items[_highlight]->getProp("type") == "dir")
             {
               if (_items[_highlight]->name() == "..") { navigateUp(); }
@@ -354,14 +353,13 @@ std::string DirListBox::exec(MouseEvent * mevent)
           }
           else if (retval == signals::quit)
           {
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
             getting_input = false;
           }
         }
         break;
 
       default:
-        _redraw_type = "none";
         break;
     }
   }
@@ -0,0 +1,107 @@
+#include <string>
+#include <vector>
+#include <map>
+#include <unistd.h>         // read, close
+#include <sys/inotify.h>
+#include "FileWatcher.h"
+
+/*******************************************************************************
+
+Constructor and destructor
+
+*******************************************************************************/
+FileWatcher::FileWatcher() { _fd = -1; }
+FileWatcher::~FileWatcher() { stop(); }
+
+/*******************************************************************************
+
+Starts and stops watching
+
+*******************************************************************************/
+int FileWatcher::start()
+{
+  stop();
+  _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_fd == -1) { return 1; }
+  return 0;
+}
+
+void FileWatcher::stop()
+{
+  if (_fd != -1) { close(_fd); }
+  _fd = -1;
+  _watches.clear();
+}
+
+/*******************************************************************************
+
+Adds a directory to watch. Returns 0 on success or 1 on error (for example, if
+the system limit on the number of watches has been reached).
+
+*******************************************************************************/
+int FileWatcher::addWatch(const std::string & path, uint32_t mask)
+{
+  int wd;
+
+  if (_fd == -1) { return 1; }
+  wd = inotify_add_watch(_fd, path.c_str(), mask | IN_ONLYDIR);
+  if (wd == -1) { return 1; }
+  _watches[wd] = path;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads all pending events without blocking. Events for watches that have been
+removed (e.g., because the directory was deleted) are skipped. Returns number
+of events read.
+
+*******************************************************************************/
+unsigned int FileWatcher::readEvents(std::vector<watchevent> & events)
+{
+  char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  const struct inotify_event *ievent;
+  std::map<int, std::string>::const_iterator it;
+  ssize_t len;
+  char *ptr;
+
+  events.resize(0);
+  if (_fd == -1) { return 0; }
+
+  while (1)
+  {
+    len = read(_fd, buf, sizeof(buf));
+    if (len <= 0) { break; }    // EAGAIN: no more events
+
+    for ( ptr = buf; ptr < buf + len;
+          ptr += sizeof(struct inotify_event) + ievent->len )
+    {
+      ievent = reinterpret_cast<const struct inotify_event *>(ptr);
+      if (ievent->mask & IN_IGNORED)
+      {
+        _watches.erase(ievent->wd);
+        continue;
+      }
+      it = _watches.find(ievent->wd);
+      if (it == _watches.end()) { continue; }
+
+      watchevent event;
+      event.path = it->second;
+      if (ievent->len > 0) { event.name = ievent->name; }
+      event.mask = ievent->mask;
+      events.push_back(event);
+    }
+  }
+
+  return events.size();
+}
+
+/*******************************************************************************
+
+Access
+
+*******************************************************************************/
+bool FileWatcher::active() const { return _fd != -1; }
+int FileWatcher::fd() const { return _fd; }
+unsigned int FileWatcher::numWatches() const { return _watches.size(); }
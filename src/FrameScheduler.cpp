@@ -0,0 +1,53 @@
+#include <curses.h>
+#include "FrameScheduler.h"
+
+FrameScheduler frame_scheduler;
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+FrameScheduler::FrameScheduler() { _pending = false; }
+
+/*******************************************************************************
+
+Schedules window and updates terminal
+
+*******************************************************************************/
+void FrameScheduler::schedule(WINDOW *win)
+{
+  wnoutrefresh(win);
+  _pending = true;
+}
+
+void FrameScheduler::update()
+{
+  if (! _pending) { return; }
+  doupdate();
+  _pending = false;
+}
+
+/*******************************************************************************
+
+Updates terminal and gets next input. If the terminal has been resized several
+times in a row, only one resize event is returned, so that windows are only
+placed and drawn once.
+
+*******************************************************************************/
+int FrameScheduler::getInput()
+{
+  int ch, next;
+
+  update();
+  ch = getch();
+  if (ch == KEY_RESIZE)
+  {
+    nodelay(stdscr, TRUE);
+    do { next = getch(); } while (next == KEY_RESIZE);
+    nodelay(stdscr, FALSE);
+    if (next != ERR) { ungetch(next); }
+  }
+
+  return ch;
+}
@@ -0,0 +1,368 @@
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>    // sort, unique, min, max
+#include <stdint.h>
+#include "BuildListItem.h"
+#include "string_util.h"
+#include "backend.h"     // get_short_description, num_jobs
+#include "ReadmeIndex.h" // tokenize
+#include "FuzzyIndex.h"
+
+/*******************************************************************************
+
+Removes everything but letters and digits from a lower case string, so that
+e.g. "gtk3" matches gtk+3. Bytes of multibyte characters are kept.
+
+*******************************************************************************/
+static std::string squash(const std::string & lowered)
+{
+  std::string squashed;
+  unsigned int i, len;
+  unsigned char c;
+
+  len = lowered.size();
+  squashed.reserve(len);
+  for ( i = 0; i < len; i++ )
+  {
+    c = lowered[i];
+    if ( ( (c >= 'a') && (c <= 'z') ) || ( (c >= '0') && (c <= '9') ) ||
+         (c >= 128) )
+      squashed.push_back(c);
+  }
+
+  return squashed;
+}
+
+/*******************************************************************************
+
+Appends the trigrams of a word, padded with a space on each side so that the
+beginning and end of the word count too
+
+*******************************************************************************/
+static void add_trigrams(const std::string & word,
+                         std::vector<uint32_t> & trigrams)
+{
+  std::string padded;
+  unsigned int i, len;
+
+  if (word.size() == 0) { return; }
+  padded = " " + word + " ";
+  len = padded.size();
+  for ( i = 0; i+2 < len; i++ )
+  {
+    trigrams.push_back( (uint32_t((unsigned char)padded[i]) << 16) |
+                        (uint32_t((unsigned char)padded[i+1]) << 8) |
+                         uint32_t((unsigned char)padded[i+2]) );
+  }
+}
+
+static void sort_unique(std::vector<uint32_t> & trigrams)
+{
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+}
+
+/*******************************************************************************
+
+Checks whether the characters of pattern appear in str in the same order
+
+*******************************************************************************/
+static bool is_subsequence(const std::string & pattern, const std::string & str)
+{
+  unsigned int i, j, plen, slen;
+
+  plen = pattern.size();
+  slen = str.size();
+  j = 0;
+  for ( i = 0; (i < slen) && (j < plen); i++ )
+  {
+    if (str[i] == pattern[j]) { j++; }
+  }
+
+  return (j == plen);
+}
+
+/*******************************************************************************
+
+Number of single-character insertions, deletions, substitutions, and swaps of
+adjacent characters needed to turn a into b. Stops early and returns
+max_dist+1 once the distance is known to be larger than max_dist.
+
+*******************************************************************************/
+static unsigned int edit_distance(const std::string & a, const std::string & b,
+                                  unsigned int max_dist)
+{
+  std::vector<unsigned int> prev2, prev, cur;
+  unsigned int i, j, alen, blen, cost, rowmin;
+
+  alen = a.size();
+  blen = b.size();
+  if (std::max(alen, blen) - std::min(alen, blen) > max_dist)
+    return max_dist+1;
+
+  prev2.assign(blen+1, 0);
+  prev.resize(blen+1);
+  cur.resize(blen+1);
+  for ( j = 0; j <= blen; j++ ) { prev[j] = j; }
+  for ( i = 1; i <= alen; i++ )
+  {
+    cur[0] = i;
+    rowmin = cur[0];
+    for ( j = 1; j <= blen; j++ )
+    {
+      if (a[i-1] == b[j-1]) { cost = 0; }
+      else { cost = 1; }
+      cur[j] = std::min(std::min(prev[j]+1, cur[j-1]+1), prev[j-1]+cost);
+      if ( (i > 1) && (j > 1) && (a[i-1] == b[j-2]) && (a[i-2] == b[j-1]) )
+        cur[j] = std::min(cur[j], prev2[j-2]+1);
+      rowmin = std::min(rowmin, cur[j]);
+    }
+    if (rowmin > max_dist) { return max_dist+1; }
+    prev2.swap(prev);
+    prev.swap(cur);
+  }
+
+  return prev[blen];
+}
+
+/*******************************************************************************
+
+Sorts matches by score, then by name
+
+*******************************************************************************/
+static bool compare_matches(const fuzzymatch & match1,
+                            const fuzzymatch & match2)
+{
+  if (match1.score != match2.score) { return (match1.score > match2.score); }
+  return (match1.build->name() < match2.build->name());
+}
+
+/*******************************************************************************
+
+Constructor and clearing
+
+*******************************************************************************/
+FuzzyIndex::FuzzyIndex() { _ready = false; }
+
+void FuzzyIndex::clear()
+{
+  _builds.clear();
+  _names.clear();
+  _squashed.clear();
+  _descs.clear();
+  _name_ntrigrams.clear();
+  _name_trigrams.clear();
+  _desc_trigrams.clear();
+  _ready = false;
+}
+
+/*******************************************************************************
+
+Creates the index for all SlackBuilds in the repository
+
+*******************************************************************************/
+void FuzzyIndex::create(std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  std::vector<std::vector<uint32_t> > name_trigrams, desc_trigrams;
+  std::vector<std::string> words;
+  std::string desc;
+  unsigned int i, j, k, nbuilds, ncategories;
+
+  clear();
+
+  ncategories = slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ ) { _builds.push_back(&slackbuilds[i][j]); }
+  }
+
+  nbuilds = _builds.size();
+  _names.resize(nbuilds);
+  _squashed.resize(nbuilds);
+  _descs.resize(nbuilds);
+  _name_ntrigrams.resize(nbuilds);
+  name_trigrams.resize(nbuilds);
+  desc_trigrams.resize(nbuilds);
+#pragma omp parallel for schedule(dynamic) private(j,desc,words) \
+                         num_threads(num_jobs())
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    _names[i] = string_to_lower(_builds[i]->name());
+    _squashed[i] = squash(_names[i]);
+    add_trigrams(_squashed[i], name_trigrams[i]);
+    sort_unique(name_trigrams[i]);
+    _name_ntrigrams[i] = name_trigrams[i].size();
+
+    get_short_description(*_builds[i], desc);
+    _descs[i] = string_to_lower(desc);
+    words.resize(0);
+    ReadmeIndex::tokenize(_descs[i], words);
+    for ( j = 0; j < words.size(); j++ )
+    {
+      add_trigrams(words[j], desc_trigrams[i]);
+    }
+    sort_unique(desc_trigrams[i]);
+  }
+
+  // Posting lists, in SlackBuild order
+
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    for ( k = 0; k < name_trigrams[i].size(); k++ )
+    {
+      _name_trigrams[name_trigrams[i][k]].push_back(i);
+    }
+    for ( k = 0; k < desc_trigrams[i].size(); k++ )
+    {
+      _desc_trigrams[desc_trigrams[i][k]].push_back(i);
+    }
+  }
+
+  _ready = true;
+}
+
+bool FuzzyIndex::ready() const { return _ready; }
+
+/*******************************************************************************
+
+Scores how well a SlackBuild name matches the search term (lower case, and
+with only letters and digits in squashed). nshared is the number of trigrams
+the name has in common with the search term, which has ntrigrams. Returns 0
+for no match.
+
+*******************************************************************************/
+int FuzzyIndex::scoreName(unsigned int idx, const std::string & term,
+                          const std::string & squashed, unsigned int nshared,
+                          unsigned int ntrigrams) const
+{
+  const std::string & name = _names[idx];
+  const std::string & sq = _squashed[idx];
+  unsigned int dist, max_dist;
+  double dice;
+
+  if (name == term) { return 1000; }
+  if (name.compare(0, term.size(), term) == 0) { return 900; }
+  if (name.find(term) != std::string::npos) { return 800; }
+  if (sq.find(squashed) != std::string::npos) { return 700; }
+
+  // The rest would match too much for very short search terms
+
+  if ( (squashed.size() < 3) || (sq.size() == 0) ) { return 0; }
+
+  if ( (sq[0] == squashed[0]) && (is_subsequence(squashed, sq)) )
+    return 500 + (100*squashed.size())/sq.size();
+
+  if (squashed.size() >= 8) { max_dist = 2; }
+  else { max_dist = 1; }
+  dist = edit_distance(squashed, sq, max_dist);
+  if (dist <= max_dist) { return 450 - 100*(int(dist)-1); }
+
+  if ( (ntrigrams > 0) && (nshared > 0) )
+  {
+    dice = 2.*double(nshared) / double(ntrigrams + _name_ntrigrams[idx]);
+    if (dice >= 0.4) { return int(300.*dice); }
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Searches names and descriptions. Only SlackBuilds sharing a trigram with the
+search term are considered, except for search terms shorter than three
+characters, which are only matched as substrings of names.
+
+*******************************************************************************/
+void FuzzyIndex::search(const std::string & searchterm,
+                        std::vector<fuzzymatch> & matches) const
+{
+  std::string term, squashed;
+  std::vector<std::string> words;
+  std::vector<uint32_t> name_query, desc_query;
+  std::vector<unsigned int> candidates, name_count, desc_count;
+  std::unordered_map<uint32_t, std::vector<unsigned int> >::const_iterator it;
+  unsigned int i, k, idx, nbuilds, ncandidates;
+  int score, descscore;
+  double ratio;
+  fuzzymatch match;
+
+  matches.resize(0);
+  term = string_to_lower(searchterm);
+  squashed = squash(term);
+  if (squashed.size() == 0) { return; }
+
+  nbuilds = _builds.size();
+  name_count.assign(nbuilds, 0);
+  desc_count.assign(nbuilds, 0);
+  if (squashed.size() < 3)
+  {
+    candidates.resize(nbuilds);
+    for ( i = 0; i < nbuilds; i++ ) { candidates[i] = i; }
+  }
+  else
+  {
+    add_trigrams(squashed, name_query);
+    sort_unique(name_query);
+    ReadmeIndex::tokenize(term, words);
+    for ( i = 0; i < words.size(); i++ )
+    {
+      add_trigrams(words[i], desc_query);
+    }
+    sort_unique(desc_query);
+
+    for ( k = 0; k < name_query.size(); k++ )
+    {
+      it = _name_trigrams.find(name_query[k]);
+      if (it == _name_trigrams.end()) { continue; }
+      for ( i = 0; i < it->second.size(); i++ )
+      {
+        idx = it->second[i];
+        if ( (name_count[idx] == 0) && (desc_count[idx] == 0) )
+          candidates.push_back(idx);
+        name_count[idx]++;
+      }
+    }
+    for ( k = 0; k < desc_query.size(); k++ )
+    {
+      it = _desc_trigrams.find(desc_query[k]);
+      if (it == _desc_trigrams.end()) { continue; }
+      for ( i = 0; i < it->second.size(); i++ )
+      {
+        idx = it->second[i];
+        if ( (name_count[idx] == 0) && (desc_count[idx] == 0) )
+          candidates.push_back(idx);
+        desc_count[idx]++;
+      }
+    }
+  }
+
+  // Score candidates
+
+  ncandidates = candidates.size();
+  for ( i = 0; i < ncandidates; i++ )
+  {
+    idx = candidates[i];
+    score = scoreName(idx, term, squashed, name_count[idx], name_query.size());
+    if ( (score < 250) && (desc_query.size() > 0) )
+    {
+      descscore = 0;
+      if (_descs[idx].find(term) != std::string::npos) { descscore = 250; }
+      else
+      {
+        ratio = double(desc_count[idx]) / double(desc_query.size());
+        if (ratio >= 0.75) { descscore = int(200.*ratio); }
+      }
+      score = std::max(score, descscore);
+    }
+    if (score == 0) { continue; }
+
+    match.build = _builds[idx];
+    match.score = score;
+    matches.push_back(match);
+  }
+
+  std::sort(matches.begin(), matches.end(), compare_matches);
+}
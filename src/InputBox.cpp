@@ -10,6 +10,7 @@
 #include "InputItem.h"
 #include "InputBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -475,7 +476,7 @@ InputBox::InputBox()
   _msg = "";
   addButton("    Ok    ", signals::keyEnter);
   addButton("  Cancel  ", signals::quit);
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _highlight = 0;
   _prevhighlight = 0;
   _reserved_rows = 6;
@@ -493,7 +494,7 @@ InputBox::InputBox(WINDOW *win, const std::string & msg)
   _msg = msg;
   addButton("    Ok    ", signals::keyEnter);
   addButton("  Cancel  ", signals::quit);
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _highlight = 0;
   _prevhighlight = 0;
   _reserved_rows = 6;
@@ -664,8 +665,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
 
           // Redraw and pause for .1 seconds to make button selection visible
 
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           draw();
+          frame_scheduler.update();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -689,9 +691,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightPreviousPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
           else
-            _redraw_type = "changed";
+            _damage |= DAMAGE_CHANGED;
           return signals::highlight;
         }
         else
@@ -703,9 +705,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightNextPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
           else
-            _redraw_type = "changed";
+            _damage |= DAMAGE_CHANGED;
           return signals::highlight;
         }
         else
@@ -717,9 +719,9 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
                double(rowsavail-1);
         check_redraw = highlightFractional(frac);
         if (check_redraw == 1)
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
         else
-          _redraw_type = "changed";
+          _damage |= DAMAGE_CHANGED;
         return signals::highlight;
       }
     }
@@ -741,7 +743,7 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
           {
             _prevhighlight = _highlight;
             _highlight = i;
-            _redraw_type = "changed";
+            _damage |= DAMAGE_CHANGED;
             draw();
             return _items[_highlight]->handleMouseEvent(mevent, y_offset);
           }
@@ -757,18 +759,18 @@ std::string InputBox::handleMouseEvent(MouseEvent * mevent)
   {
     check_redraw = highlightPreviousPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
     else
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
     return signals::highlight;
   }
   else if (mevent->button() == 5)
   {
     check_redraw = highlightNextPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
     else
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
     return signals::highlight;
   }
   else
@@ -782,9 +784,9 @@ Redraws box and all input items
 *******************************************************************************/
 void InputBox::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _damage = DAMAGE_ALL; }
 
-  if (_redraw_type == "all") 
+  if (_damage & DAMAGE_BACKGROUND)
   { 
     clearWindow();
     if (_color_idx == -1)
@@ -796,14 +798,15 @@ void InputBox::draw(bool force)
   }
   else
   {
-    if (_redraw_type == "buttons") { redrawButtons(); }
-    else
-    {
-      redrawChangedItems(force);
-      if (_has_scroll_indicator) { redrawScrollIndicator(); }
-    }
+    // Input items keep track of their own damage
+
+    if (_damage & DAMAGE_BUTTONS) { redrawButtons(); }
+    redrawChangedItems(force);
+    if ( (_damage & DAMAGE_SCROLL) && _has_scroll_indicator )
+      redrawScrollIndicator();
   }
-  wrefresh(_win);
+  _damage = DAMAGE_NONE;
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -821,7 +824,7 @@ std::string InputBox::handleInput(std::string & selection, bool & getting_input,
   retval = selection;
   if (selection == signals::resize)
   {
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
     getting_input = false;
   }
   else if (selection == signals::keyEnter)
@@ -830,50 +833,50 @@ std::string InputBox::handleInput(std::string & selection, bool & getting_input,
       retval = _button_signals[_highlighted_button];
     else
       retval = signals::keyEnter;
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
     getting_input = false;
   }
   else if ( (selection == signals::quit) ||
             (selection == signals::keySpace) )
   {
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
     getting_input = false;
   }
   else if (selection == signals::highlightFirst)
   { 
-    if (highlightFirst() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightFirst() == 1) { _damage |= DAMAGE_ALL; }
+    else { _damage |= DAMAGE_CHANGED; }
   }
   else if (selection == signals::highlightLast) 
   { 
-    if (highlightLast() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightLast() == 1) { _damage |= DAMAGE_ALL; }
+    else { _damage |= DAMAGE_CHANGED; }
   }
   else if (selection == signals::highlightPrevPage)
   {
-    if (highlightPreviousPage() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightPreviousPage() == 1) { _damage |= DAMAGE_ALL; }
+    else { _damage |= DAMAGE_CHANGED; }
   }
   else if (selection == signals::highlightNextPage)
   {
-    if (highlightNextPage() == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (highlightNextPage() == 1) { _damage |= DAMAGE_ALL; }
+    else { _damage |= DAMAGE_CHANGED; }
   }
   else if (selection == signals::highlightPrev)
   { 
     if (_highlight == _first_selectable)
       check_redraw = highlightFirst();
     else { check_redraw = highlightPrevious(); }
-    if (check_redraw == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (check_redraw == 1) { _damage |= DAMAGE_ALL; }
+    else { _damage |= DAMAGE_CHANGED; }
   }
   else if (selection == signals::highlightNext)
   {
     if (_highlight == _last_selectable)
       check_redraw = highlightLast();
     else { check_redraw = highlightNext(); }
-    if (check_redraw == 1) { _redraw_type = "all"; }
-    else { _redraw_type = "changed"; }
+    if (check_redraw == 1) { _damage |= DAMAGE_ALL; }
+    else { _damage |= DAMAGE_CHANGED; }
   }
   else if (selection == signals::mouseEvent)
   {
@@ -889,23 +892,21 @@ std::string InputBox::handleInput(std::string & selection, bool & getting_input,
       needs_selection = false;
       getting_input = true;
     }
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
   }
   else if (selection == signals::keyRight)
   {
     check_redraw = highlightNextButton();
-    if (check_redraw == 1) { _redraw_type = "buttons"; }
-    else { _redraw_type = "none"; }
+    if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
   }
   else if (selection == signals::keyLeft)
   {
     check_redraw = highlightPreviousButton();
-    if (check_redraw == 1) { _redraw_type = "buttons"; }
-    else { _redraw_type = "none"; }
+    if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
   }
   else
   {
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
     getting_input = false;
   }
 
@@ -930,7 +931,7 @@ std::string InputBox::exec(MouseEvent * mevent)
     // Draw input box elements
   
     draw();
-    _redraw_type = "changed";
+    _damage |= DAMAGE_CHANGED;
     y_offset = _firstprint - _header_rows;
 
     // Get user input from highlighted item
@@ -55,7 +55,7 @@ InputItem::InputItem()
   _posy = 0;
   _width = 0;
   _name = "";
-  _redraw_type = "none";
+  _damage = DAMAGE_NONE;
   _item_type = "none";
   _selectable = true;
   _auto_position = true;
@@ -3,16 +3,51 @@
 #include <string>
 #include <curses.h>
 #include <cmath>     // floor
-#include <algorithm> // max, min
+#include <algorithm> // max, min, find
+#include <unordered_set>
 #include "Color.h"
 #include "settings.h"
 #include "string_util.h"
 #include "signals.h"
-#include "requirements.h"
+#include "DependencyGraph.h"
 #include "backend.h"
 #include "BuildListItem.h"
+#include "DirListing.h"
+#include "BuildScheduler.h"
 #include "InstallBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
+
+/*******************************************************************************
+
+Layout: width of the action column, cached with the other metrics, and location
+of the divider between the name and action columns
+
+*******************************************************************************/
+void InstallBox::computeMetrics() const
+{
+  int actionlen;
+  unsigned int i, nitems;
+
+  BuildOrderBox::computeMetrics();
+
+  _action_cols = 0;
+  nitems = _items.size();
+  for ( i = 0; i < nitems; i++ )
+  {
+    actionlen = _items[i]->getProp("action").size() + 1;
+    if (actionlen > _action_cols) { _action_cols = actionlen; }
+  }
+}
+
+int InstallBox::dividerColumn() const
+{
+  int rows, cols;
+
+  checkMetrics();
+  getmaxyx(_win, rows, cols);
+  return cols-2 - _action_cols - 1;
+}
 
 /*******************************************************************************
 
@@ -21,8 +56,7 @@ Draws window border and title
 *******************************************************************************/
 void InstallBox::redrawFrame()
 {
-  int rows, cols, namelen, i, nspaces, action_cols, vlineloc;
-  unsigned int j, nitems, actionlen;
+  int rows, cols, namelen, i, nspaces, vlineloc;
   double mid, left, right;
 
   getmaxyx(_win, rows, cols);
@@ -78,14 +112,7 @@ void InstallBox::redrawFrame()
   colors.turnOn(_win, "header_popup", "bg_popup");
   wprintw(_win, "Name");
 
-  nitems = _items.size();
-  action_cols = 0;
-  for ( j = 0; j < nitems; j++ )
-  {
-    actionlen = _items[j]->getProp("action").size() + 1;
-    if (int(actionlen) > action_cols) { action_cols = actionlen; }
-  }
-  vlineloc = cols-2 - action_cols - 1;
+  vlineloc = dividerColumn();
   nspaces = vlineloc - std::string("Name").size();
   for ( i = 0; i < nspaces; i++ ) { waddch(_win, ' '); }
 
@@ -124,21 +151,11 @@ screen or not.
 void InstallBox::redrawSingleItem(unsigned int idx)
 {
   std::string fg, bg;
-  int nspaces, actionlen, action_cols, vlineloc, printlen, rows, cols, i;
-  unsigned int j, nitems;
-
-  getmaxyx(_win, rows, cols);
+  int nspaces, vlineloc, printlen, i;
 
   // Print divider before applying color
 
-  nitems = _items.size();
-  action_cols = 0;
-  for ( j = 0; j < nitems; j++ )
-  {
-    actionlen = _items[j]->getProp("action").size() + 1;
-    if (actionlen > action_cols) { action_cols = actionlen; }
-  }
-  vlineloc = cols-2 - action_cols - 1;
+  vlineloc = dividerColumn();
   wmove(_win, idx-_firstprint+_header_rows, vlineloc);
   waddch(_win, ACS_VLINE);
 
@@ -222,8 +239,12 @@ InstallBox::InstallBox()
   button_signals[2] = "a";
   setButtons(buttons, button_signals);
   _builds.resize(0);
+  _requested.resize(0);
+  _slackbuilds = NULL;
   _ndeps = 0;
+  _nrequested = 0;
   _ninvdeps = 0;
+  _action_cols = 0;
 }
 
 InstallBox::InstallBox(WINDOW *win, const std::string & name)
@@ -238,8 +259,12 @@ InstallBox::InstallBox(WINDOW *win, const std::string & name)
   button_signals[2] = "a";
   setButtons(buttons, button_signals);
   _builds.resize(0);
+  _requested.resize(0);
+  _slackbuilds = NULL;
   _ndeps = 0;
+  _nrequested = 0;
   _ninvdeps = 0;
+  _action_cols = 0;
   _win = win;
   _name = name;
 }
@@ -251,19 +276,17 @@ Get attributes
 *******************************************************************************/
 void InstallBox::minimumSize(int & height, int & width) const
 {
-  int namelen, actionlen, reserved_cols, action_cols;
-  unsigned int i, nitems, nbuttons;
+  int namelen, reserved_cols;
+  unsigned int i, nbuttons;
 
   // Minimum usable height
 
-  nitems = _items.size();
   height = _reserved_rows + 2;
 
   // Minimum usable width
 
   reserved_cols = 2;
   width = _name.size();
-  action_cols = 0;
   nbuttons = _buttons.size();
   if (nbuttons > 0)
   {
@@ -274,13 +297,9 @@ void InstallBox::minimumSize(int & height, int & width) const
     }
     if (namelen > width) { width = namelen; }
   }
-  for ( i = 0; i < nitems; i++ )
-  {
-    actionlen = _items[i]->getProp("action").size() + 1;
-    if (actionlen > action_cols) { action_cols = actionlen; }
-    namelen = _items[i]->name().size() + 4 + action_cols;
-    if (namelen > width) { width = namelen; }
-  }
+  checkMetrics();
+  namelen = _max_name_len + 4 + _action_cols;
+  if (namelen > width) { width = namelen; }
   width += reserved_cols;
 }
 
@@ -313,8 +332,9 @@ bool InstallBox::installingAllDeps() const
 {
   int i;
 
-  for ( i = 0; i < _ndeps; i++ )
+  for ( i = 0; i < _ndeps + _nrequested; i++ )
   {
+    if (_requested[i]) { continue; }
     if ( ((_items[i]->getProp("action") != "Remove") &&
           (_items[i]->getProp("action") != "Reinstall")) &&
          (! _items[i]->getBoolProp("marked")) ) { return false; }
@@ -325,84 +345,61 @@ bool InstallBox::installingAllDeps() const
 
 bool InstallBox::installingRequested() const
 {
-  if ( (_items[_ndeps]->getProp("action") != "Remove") &&
-       (_items[_ndeps]->getBoolProp("marked")) ) { return true; }
-  else { return false; }
+  int i;
+
+  for ( i = 0; i < _ndeps + _nrequested; i++ )
+  {
+    if (! _requested[i]) { continue; }
+    if ( (_items[i]->getProp("action") != "Remove") &&
+         (_items[i]->getBoolProp("marked")) ) { return true; }
+  }
+
+  return false;
 }
 
 /*******************************************************************************
 
-Creates list based on SlackBuild selected. Returns 0 if dependency resolution
-succeeded or 1 if some could not be found in the repository.
+Sets up the list from a build order. SlackBuilds in requested are the ones the
+user asked for; the rest are dependencies. Also adds inverse dependencies of
+requested SlackBuilds if requested and in upgrade mode.
 
 *******************************************************************************/
-int InstallBox::create(BuildListItem & build,
-                       std::vector<std::vector<BuildListItem> > & slackbuilds,
-                       const std::string & action, bool resolve_deps,
-                       bool batch, bool rebuild_inv_deps) 
+void InstallBox::createFromPlan(const std::vector<BuildListItem *> & plan,
+                                const std::vector<BuildListItem *> & requested,
+                        std::vector<std::vector<BuildListItem> > & slackbuilds,
+                                const std::string & action,
+                                bool rebuild_inv_deps)
 {
-  int check; 
-  unsigned int i, nbuilds;
-  bool mark;
+  unsigned int i, j, nplan, nrequested, nbuilds;
+  bool mark, is_requested;
   std::string action_applied;
-  std::string installed_version, available_version;
   std::vector<BuildListItem *> reqlist;
-  std::vector<std::string> buttons, button_signals;
+  std::unordered_set<BuildListItem *> requested_set, listed;
 
-  // Get list of reqs and/or add requested SlackBuild to list
-
-  check = 0;
-  _ndeps = 0;
-  reqlist.resize(0);
-  if (resolve_deps)
-    check = compute_reqs_order(build, reqlist, slackbuilds);
-
-  _ndeps = reqlist.size();
-  reqlist.push_back(&build);
-
-  if (batch)
-  { 
-    buttons.resize(4);
-    button_signals.resize(4);
-    buttons[0] = "   Ok   ";
-    buttons[1] = "  Skip  ";
-    buttons[2] = " Cancel ";
-    buttons[3] = " Actions ";
-    button_signals[0] = signals::keyEnter;
-    button_signals[1] = signals::quit;
-    button_signals[2] = "c";
-    button_signals[3] = "a";
-  }
-  else
-  {
-    buttons.resize(3);
-    button_signals.resize(3);
-    buttons[0] = "   Ok   ";
-    buttons[1] = " Cancel ";
-    buttons[2] = " Actions ";
-    button_signals[0] = signals::keyEnter;
-    button_signals[1] = signals::quit;
-    button_signals[2] = "a";
-  }
-  setButtons(buttons, button_signals);
+  _slackbuilds = &slackbuilds;
+  requested_set.insert(requested.begin(), requested.end());
 
-  // Copy reqlist to _builds list and determine action for each
+  // Copy plan to _builds list and determine action for each
 
   nbuilds = 0;
-  for ( i = 0; int(i) <= _ndeps; i++ )
+  _nrequested = 0;
+  nplan = plan.size();
+  for ( i = 0; i < nplan; i++ )
   {
     mark = false;
+    is_requested = (requested_set.count(plan[i]) > 0);
     if (action != "Remove")
     {
-      _builds.push_back(reqlist[i]);
-      if (! reqlist[i]->getBoolProp("installed"))
+      _builds.push_back(plan[i]);
+      _requested.push_back(is_requested);
+      if (! plan[i]->getBoolProp("installed"))
       {
         mark = true;
         action_applied = "Install";
       }
       else
       {
-        if (reqlist[i]->getBoolProp("upgradable"))
+        if (plan[i]->getBoolProp("upgradable"))
         {
           mark = true;
           action_applied = "Upgrade";
@@ -411,56 +408,65 @@ int InstallBox::create(BuildListItem & build,
         {
           // By default, do not reinstall dependencies
 
-          if ( (action == "Reinstall") && (int(i) == _ndeps) ) { mark = true; }
+          if ( (action == "Reinstall") && (is_requested) ) { mark = true; }
           else { mark = false; }
           action_applied = "Reinstall";
         }
       }
       _builds[nbuilds]->setBoolProp("marked", mark);
       _builds[nbuilds]->setProp("action", action_applied);
+      if (is_requested) { _nrequested++; }
       nbuilds++;
     }
     else
     {
-      if (reqlist[i]->getBoolProp("installed"))
+      if (plan[i]->getBoolProp("installed"))
       {
-        _builds.push_back(reqlist[i]);
-        
+        _builds.push_back(plan[i]);
+        _requested.push_back(is_requested);
+
         // By default, do not remove dependencies
 
-        if (int(i) == _ndeps) { mark = true; }
-        else { mark = false; }
+        mark = is_requested;
         action_applied = "Remove";
         _builds[nbuilds]->setBoolProp("marked", mark);
         _builds[nbuilds]->setProp("action", action_applied);
+        if (is_requested) { _nrequested++; }
         nbuilds++;
       }
     }
   }
 
-  // When removing, we only consider installed dependencies, so reset _ndeps
-  // appropriately
+  // When removing, we only consider installed dependencies, so the list can
+  // be empty. In that case _ndeps is set to -1.
 
-  if (action == "Remove")
-    _ndeps = nbuilds - 1;
+  if (nbuilds == 0) { _ndeps = -1; }
+  else { _ndeps = nbuilds - _nrequested; }
 
   // Rebuild inverse deps if requested and in upgrade mode
 
+  _ninvdeps = 0;
   if ((action == "Upgrade") && rebuild_inv_deps)
   {
-    reqlist.resize(0);
-    compute_inv_reqs(build, reqlist, slackbuilds);
-    _ninvdeps = reqlist.size();
-    
-    for ( i = 0; int(i) < _ninvdeps; i++ )
+    listed.insert(_builds.begin(), _builds.end());
+    nrequested = requested.size();
+    for ( j = 0; j < nrequested; j++ )
     {
-      _builds.push_back(reqlist[i]);
-      _builds[nbuilds]->setBoolProp("marked", true);
-      if (_builds[nbuilds]->getBoolProp("upgradable"))
-        _builds[nbuilds]->setProp("action", "Upgrade");
-      else
-        _builds[nbuilds]->setProp("action", "Reinstall");
-      nbuilds++;
+      dependency_graph.invReqs(*requested[j], reqlist, slackbuilds);
+      for ( i = 0; i < reqlist.size(); i++ )
+      {
+        if (listed.count(reqlist[i]) > 0) { continue; }
+        listed.insert(reqlist[i]);
+        _builds.push_back(reqlist[i]);
+        _requested.push_back(false);
+        _builds[nbuilds]->setBoolProp("marked", true);
+        if (_builds[nbuilds]->getBoolProp("upgradable"))
+          _builds[nbuilds]->setProp("action", "Upgrade");
+        else
+          _builds[nbuilds]->setProp("action", "Reinstall");
+        _ninvdeps++;
+        nbuilds++;
+      }
     }
   }
 
@@ -479,6 +485,60 @@ int InstallBox::create(BuildListItem & build,
       _builds[i]->setProp("action", "(blacklisted)");
     }
   }
+  invalidateMetrics();
+}
+
+/*******************************************************************************
+
+Creates list based on SlackBuild selected. Returns 0 if dependency resolution
+succeeded or 1 if some could not be found in the repository.
+
+*******************************************************************************/
+int InstallBox::create(BuildListItem & build,
+                       std::vector<std::vector<BuildListItem> > & slackbuilds,
+                       const std::string & action, bool resolve_deps,
+                       bool batch, bool rebuild_inv_deps) 
+{
+  int check; 
+  std::vector<BuildListItem *> reqlist, requested;
+  std::vector<std::string> buttons, button_signals;
+
+  // Get list of reqs and/or add requested SlackBuild to list
+
+  check = 0;
+  reqlist.resize(0);
+  if (resolve_deps)
+    check = dependency_graph.reqsOrder(build, reqlist, slackbuilds);
+  reqlist.push_back(&build);
+  requested.push_back(&build);
+
+  if (batch)
+  { 
+    buttons.resize(4);
+    button_signals.resize(4);
+    buttons[0] = "   Ok   ";
+    buttons[1] = "  Skip  ";
+    buttons[2] = " Cancel ";
+    buttons[3] = " Actions ";
+    button_signals[0] = signals::keyEnter;
+    button_signals[1] = signals::quit;
+    button_signals[2] = "c";
+    button_signals[3] = "a";
+  }
+  else
+  {
+    buttons.resize(3);
+    button_signals.resize(3);
+    buttons[0] = "   Ok   ";
+    buttons[1] = " Cancel ";
+    buttons[2] = " Actions ";
+    button_signals[0] = signals::keyEnter;
+    button_signals[1] = signals::quit;
+    button_signals[2] = "a";
+  }
+  setButtons(buttons, button_signals);
+
+  createFromPlan(reqlist, requested, slackbuilds, action, rebuild_inv_deps);
 
   // Set window title
 
@@ -510,6 +570,47 @@ int InstallBox::create(BuildListItem & build,
 
 /*******************************************************************************
 
+Creates one list for several SlackBuilds, with their dependencies merged into a
+single build order so that shared dependencies are listed only once. Returns 0
+if dependency resolution succeeded, 1 if some could not be found in the
+repository, or 2 if a .info file is missing.
+
+*******************************************************************************/
+int InstallBox::create(const std::vector<BuildListItem *> & builds,
+                       std::vector<std::vector<BuildListItem> > & slackbuilds,
+                       const std::string & action, bool resolve_deps,
+                       bool rebuild_inv_deps)
+{
+  int check;
+  std::vector<BuildListItem *> plan;
+  std::string title;
+
+  check = 0;
+  if (resolve_deps)
+    check = dependency_graph.planOrder(builds, plan, slackbuilds);
+  else { plan = builds; }
+
+  createFromPlan(plan, builds, slackbuilds, action, rebuild_inv_deps);
+
+  // Set window title
+
+  if (_nrequested == 1) { title = "1 SlackBuild"; }
+  else { title = int_to_string(_nrequested) + " SlackBuilds"; }
+  if (! resolve_deps) { title += " (deps ignored)"; }
+  else
+  {
+    title += " (" + int_to_string(std::max(_ndeps, 0));
+    if (action == "Remove") { title += " installed"; }
+    if (_ndeps == 1) { title += " dep)"; }
+    else { title += " deps)"; }
+  }
+  setName(title);
+
+  return check;
+}
+
+/*******************************************************************************
+
 Handles mouse event
 
 *******************************************************************************/
@@ -542,7 +643,7 @@ std::string InstallBox::handleMouseEvent(MouseEvent * mevent)
     {
       _items[_highlight]->setBoolProp("marked", 
                                  (! _items[_highlight]->getBoolProp("marked")));
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
     }
   }
 
@@ -574,14 +675,14 @@ std::string InstallBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: accept selection
 
     case '\n':
     case '\r':
     case KEY_ENTER:
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       if (int(_button_signals.size()) >= _highlighted_button+1)
         retval = _button_signals[_highlighted_button];
       else
@@ -593,38 +694,38 @@ std::string InstallBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::highlight;
       check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_DOWN:
       retval = signals::highlight;
       check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_PPAGE:
       retval = signals::highlight;
       check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_NPAGE:
       retval = signals::highlight;
       check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     // Right/Left: change highlighted button
@@ -632,29 +733,27 @@ std::string InstallBox::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      if (check_redraw == 1) { _redraw_type = "changed"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      if (check_redraw == 1) { _redraw_type = "changed"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Space: toggle item
@@ -665,21 +764,20 @@ std::string InstallBox::exec(MouseEvent * mevent)
       {
         _items[_highlight]->setBoolProp("marked", 
                                  (! _items[_highlight]->getBoolProp("marked")));
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
       }
-      else { _redraw_type = "none"; }
       break;
 
     // t and T: tag item
 
     case 't':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     case 'T':
       retval = signals::tag;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Mouse
@@ -688,17 +786,16 @@ std::string InstallBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
         retval = handleMouseEvent(mevent);
         if ( (retval == signals::keyEnter) || (retval == signals::quit) ||
              (retval == "c") || (retval == "a") )
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
       }
       break;
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
       break;
   }
   curs_set(0);
@@ -738,6 +835,236 @@ std::vector<const BuildListItem *> InstallBox::checkForeign() const
 
 /*******************************************************************************
 
+Downloads and checks sources for all selected SlackBuilds before building any
+of them, several at a time. The backend uses sources that are already there
+instead of downloading them again, so a download that fails here is just
+tried again (with output to the terminal) when the SlackBuild is built.
+
+*******************************************************************************/
+void InstallBox::prefetchSources()
+{
+  unsigned int nbuilds, i;
+  int idx;
+  std::string action, logdir;
+  std::vector<int> build_of;
+  BuildScheduler scheduler;
+  DirListing listing;
+
+  logdir = "/var/log/sboui";
+  listing.createFromPath(logdir);
+
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (! _builds[i]->getBoolProp("marked")) { continue; }
+    action = _builds[i]->getProp("action");
+    if (action == "Remove") { continue; }
+    scheduler.addJob(pipeline_command(*_builds[i], action, "fetch"),
+                     logdir + "/" + _builds[i]->name() + "-fetch.log",
+                     std::vector<int>());
+    build_of.push_back(i);
+  }
+  if (build_of.size() == 0) { return; }
+
+  scheduler.setMaxJobs(settings::fetch_jobs);
+  std::cout << "Fetching sources for " << build_of.size()
+            << " SlackBuilds, up to " << settings::fetch_jobs
+            << " at a time." << std::endl;
+  while (! scheduler.finished())
+  {
+    scheduler.startReady();
+    if (scheduler.waitJob(idx) != 0) { continue; }
+    if (scheduler.job(idx).status != 0)
+      std::cout << _builds[build_of[idx]]->name() << ": could not fetch "
+                << "sources. See " << scheduler.job(idx).log << "."
+                << std::endl;
+  }
+}
+
+/*******************************************************************************
+
+Checks whether changes can be applied with more than one build at a time, or
+with pipelined builds. This requires the built-in package manager, which keeps
+parallel builds apart and installs one package at a time, and no SlackBuilds
+to remove.
+
+*******************************************************************************/
+bool InstallBox::buildInParallel() const
+{
+  unsigned int i, nbuilds;
+
+  if ( ( (settings::build_jobs <= 1) && (! settings::pipeline_builds) ) ||
+       (settings::package_manager != "built-in") ||
+       (_slackbuilds == NULL) ) { return false; }
+
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if ( (_builds[i]->getBoolProp("marked")) &&
+         (_builds[i]->getProp("action") == "Remove") ) { return false; }
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+
+Installs, upgrades, or reinstalls selected SlackBuilds, building those that do
+not depend on each other at the same time. With pipelined builds, each
+SlackBuild is fetched, built, and installed in separate steps, so sources for
+later SlackBuilds are downloaded and packages are built while earlier ones are
+installed. Output of each step goes to a log file in /var/log/sboui. Returns 0
+on success. Also counts number of SlackBuilds that were changed.
+
+*******************************************************************************/
+int InstallBox::applyChangesParallel(int & ninstalled, int & nupgraded,
+                                     int & nreinstalled)
+{
+  unsigned int nbuilds, nselected, i, k;
+  int retval, idx, check, fetch_job, build_job;
+  std::string action, response, logdir, logbase;
+  std::vector<int> job_of, build_of, prereqs;
+  std::vector<bool> failed;
+  std::vector<BuildListItem *> reqlist;
+  BuildScheduler scheduler;
+  DirListing listing;
+
+  // Job classes, each with its own limit
+
+  const unsigned int fetch_class = 0;
+  const unsigned int build_class = 1;
+  const unsigned int install_class = 2;
+
+  logdir = "/var/log/sboui";
+  listing.createFromPath(logdir);
+
+  // Jobs for each selected SlackBuild. The last job of each (install, or the
+  // whole thing if not pipelined) waits on the last job of each selected
+  // requirement, so it is built against the installed requirements.
+
+  nbuilds = _builds.size();
+  nselected = 0;
+  job_of.assign(nbuilds, -1);
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (! _builds[i]->getBoolProp("marked")) { continue; }
+    nselected++;
+
+    prereqs.resize(0);
+    dependency_graph.reqsOrder(*_builds[i], reqlist, *_slackbuilds);
+    for ( k = 0; k < nbuilds; k++ )
+    {
+      if ( (k == i) || (job_of[k] == -1) ) { continue; }
+      if (std::find(reqlist.begin(), reqlist.end(), _builds[k]) !=
+          reqlist.end()) { prereqs.push_back(job_of[k]); }
+    }
+
+    action = _builds[i]->getProp("action");
+    logbase = logdir + "/" + _builds[i]->name();
+    if (settings::pipeline_builds)
+    {
+      fetch_job = scheduler.addJob(
+                          pipeline_command(*_builds[i], action, "fetch"),
+                          logbase + "-fetch.log", std::vector<int>(),
+                          fetch_class);
+      build_of.push_back(i);
+      prereqs.push_back(fetch_job);
+      build_job = scheduler.addJob(
+                          pipeline_command(*_builds[i], action, "build"),
+                          logbase + "-build.log", prereqs, build_class);
+      build_of.push_back(i);
+      job_of[i] = scheduler.addJob(
+                          pipeline_command(*_builds[i], action, "install"),
+                          logbase + ".log", std::vector<int>(1, build_job),
+                          install_class);
+    }
+    else
+      job_of[i] = scheduler.addJob(install_command(*_builds[i], action),
+                                   logbase + ".log", prereqs, build_class);
+    build_of.push_back(i);
+  }
+
+  // Run jobs, checking each result as it finishes. Sources are fetched ahead
+  // of the builds, and packages are installed one at a time.
+
+  scheduler.setMaxJobs(settings::fetch_jobs, fetch_class);
+  scheduler.setMaxJobs(settings::build_jobs, build_class);
+  scheduler.setMaxJobs(1, install_class);
+  std::cout << "Building " << nselected << " SlackBuilds, up to "
+            << settings::build_jobs << " at a time. Build logs are in "
+            << logdir << "." << std::endl;
+  retval = 0;
+  failed.assign(nbuilds, false);
+  while (! scheduler.finished())
+  {
+    scheduler.startReady();
+    if (scheduler.waitJob(idx) != 0) { continue; }
+
+    i = build_of[idx];
+    action = _builds[i]->getProp("action");
+    check = scheduler.job(idx).status;
+    if (check != 0)
+    {
+      scheduler.markFailed(idx);
+      failed[i] = true;
+      std::cout << _builds[i]->name() << ": failed. See "
+                << scheduler.job(idx).log << "." << std::endl;
+      retval = 1;
+      continue;
+    }
+
+    // An upgrade that didn't take is reported as failed rather than
+    // reinstalled here, since that would rebuild in the foreground while
+    // other jobs are still running
+
+    if ( (idx == job_of[i]) &&
+         (check_install(*_builds[i], action, false) != 0) )
+    {
+      scheduler.markFailed(idx);
+      failed[i] = true;
+      std::cout << _builds[i]->name() << ": " << string_to_lower(action)
+                << " did not take effect. Try reinstalling it." << std::endl;
+      retval = 1;
+      continue;
+    }
+
+    if (scheduler.job(idx).jobclass == fetch_class)
+      std::cout << _builds[i]->name() << ": fetched." << std::endl;
+    else if (idx != job_of[i])
+      std::cout << _builds[i]->name() << ": built." << std::endl;
+    else
+    {
+      std::cout << _builds[i]->name() << ": done." << std::endl;
+      if (action == "Install") { ninstalled++; }
+      else if (action == "Upgrade") { nupgraded++; }
+      else { nreinstalled++; }
+    }
+  }
+
+  // Report SlackBuilds that were skipped because a requirement failed
+
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if ( (job_of[i] == -1) || (failed[i]) ) { continue; }
+    if (scheduler.job(job_of[i]).state == JOB_SKIPPED)
+    {
+      std::cout << _builds[i]->name()
+                << ": skipped because a requirement failed." << std::endl;
+      retval = 1;
+    }
+  }
+
+  if (retval != 0)
+  {
+    std::cout << "Press Enter to return to main window ...";
+    std::getline(std::cin, response);
+  }
+
+  return retval;
+}
+
+/*******************************************************************************
+
 Install, upgrade, reinstall, or remove SlackBuild and dependencies. Returns 0 on
 success. Also counts number of SlackBuilds that were changed.
 
@@ -749,6 +1076,15 @@ int InstallBox::applyChanges(int & ninstalled, int & nupgraded,
   int retval;
   std::string action, response, msg;
 
+  // Download all sources first, unless pipelined builds do that as they go
+
+  if ( (settings::package_manager == "built-in") &&
+       (settings::fetch_jobs > 1) && (! settings::pipeline_builds) )
+    prefetchSources();
+
+  if (buildInParallel())
+    return applyChangesParallel(ninstalled, nupgraded, nreinstalled);
+
   // Install/upgrade/reinstall/remove selected SlackBuilds
 
   nbuilds = _builds.size();
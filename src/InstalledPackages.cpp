@@ -0,0 +1,151 @@
+#include <string>
+#include <vector>
+#include <algorithm>    // sort
+#include <glob.h>
+#include "DirListing.h"
+#include "backend.h"    // get_pkg_info, num_jobs
+#include "InstalledPackages.h"
+
+/*******************************************************************************
+
+Compares installed packages by full package name
+
+*******************************************************************************/
+static bool compare_pkgs(const installedpkg *pkg1, const installedpkg *pkg2)
+{
+  return pkg1->pkg < pkg2->pkg;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+InstalledPackages::InstalledPackages()
+{
+  _package_dir = "";
+  _invalid.resize(0);
+  _loaded = false;
+}
+
+/*******************************************************************************
+
+Reads the package directory. If more than one installed package has the same
+name, the last one listed is used. Returns 0 on success or 1 if the directory
+cannot be read.
+
+*******************************************************************************/
+int InstalledPackages::read(const std::string & package_dir)
+{
+  DirListing listing;
+  std::vector<installedpkg> pkgs;
+  std::vector<int> checks;
+  unsigned int i, npackages;
+
+  _package_dir = package_dir;
+  _packages.clear();
+  _invalid.resize(0);
+  _loaded = false;
+
+  if (listing.setFromPath(package_dir, false, false) == 1) { return 1; }
+
+  // Parse package names in parallel, then add them in listing order
+
+  npackages = listing.size();
+  pkgs.resize(npackages);
+  checks.resize(npackages);
+#pragma omp parallel for schedule(dynamic) num_threads(num_jobs())
+  for ( i = 0; i < npackages; i++ )
+  {
+    pkgs[i].pkg = listing(i).name;
+    checks[i] = get_pkg_info(pkgs[i].pkg, pkgs[i].name, pkgs[i].version,
+                             pkgs[i].arch, pkgs[i].build);
+  }
+
+  _packages.reserve(npackages);
+  for ( i = 0; i < npackages; i++ )
+  {
+    if (checks[i] != 0) { _invalid.push_back(pkgs[i].pkg); }
+    else { _packages[pkgs[i].name] = pkgs[i]; }
+  }
+  _loaded = true;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Rechecks installed packages with the given name. Only package files starting
+with name- are looked at. Returns 0 if the package is installed or 1 if not.
+
+*******************************************************************************/
+int InstalledPackages::update(const std::string & name)
+{
+  glob_t matches;
+  installedpkg pkg;
+  std::string path;
+  unsigned int i;
+  bool found;
+
+  _packages.erase(name);
+
+  found = false;
+  if (glob((_package_dir + "/" + name + "-*").c_str(), 0, NULL, &matches) == 0)
+  {
+    for ( i = 0; i < matches.gl_pathc; i++ )
+    {
+      // Glob also matches longer names like name-foo-1.0-x86_64-1
+
+      path = matches.gl_pathv[i];
+      pkg.pkg = path.substr(path.find_last_of('/')+1);
+      if (get_pkg_info(pkg.pkg, pkg.name, pkg.version, pkg.arch,
+                       pkg.build) != 0) { continue; }
+      if (pkg.name != name) { continue; }
+      _packages[name] = pkg;
+      found = true;
+    }
+  }
+  globfree(&matches);
+
+  if (found) { return 0; }
+  else { return 1; }
+}
+
+/*******************************************************************************
+
+Access
+
+*******************************************************************************/
+bool InstalledPackages::loaded() const { return _loaded; }
+unsigned int InstalledPackages::size() const { return _packages.size(); }
+
+const installedpkg * InstalledPackages::find(const std::string & name) const
+{
+  std::unordered_map<std::string, installedpkg>::const_iterator it;
+
+  it = _packages.find(name);
+  if (it == _packages.end()) { return NULL; }
+  else { return &it->second; }
+}
+
+// List of installed packages, sorted by full package name
+
+std::vector<const installedpkg *> InstalledPackages::list() const
+{
+  std::vector<const installedpkg *> pkglist;
+  std::unordered_map<std::string, installedpkg>::const_iterator it;
+
+  pkglist.reserve(_packages.size());
+  for ( it = _packages.begin(); it != _packages.end(); it++ )
+  {
+    pkglist.push_back(&it->second);
+  }
+  std::sort(pkglist.begin(), pkglist.end(), compare_pkgs);
+
+  return pkglist;
+}
+
+const std::vector<std::string> & InstalledPackages::invalid() const
+{
+  return _invalid;
+}
@@ -21,6 +21,7 @@ void KeyHelpWindow::createList()
   addItem(new HelpItem("Activate menubar", "F9"));
   addItem(new HelpItem("Activate right/bottom list", "Right arrow"));
   addItem(new HelpItem("Filter", "f"));
+  addItem(new HelpItem("Live search (filter as you type)", "Ctrl-f"));
   addItem(new HelpItem("Show keyboard shortcuts", "?"));
   addItem(new HelpItem("Options", "o"));
   addItem(new HelpItem("Quick search in active list", "Ctrl-s"));
@@ -6,6 +6,7 @@
 #include "InputItem.h"
 #include "Label.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -14,7 +15,7 @@ Constructors and destructor
 *******************************************************************************/
 Label::Label()
 {
-  _redraw_type = "label";
+  _damage = DAMAGE_LABEL;
   _item_type = "Label";
   _color_idx = -1;
   _selectable = false;
@@ -24,7 +25,7 @@ Label::Label()
 
 Label::Label(bool selectable)
 {
-  _redraw_type = "label";
+  _damage = DAMAGE_LABEL;
   _item_type = "Label";
   _color_idx = -1;
   _selectable = selectable;
@@ -34,7 +35,7 @@ Label::Label(bool selectable)
 
 Label::Label(bool selectable, bool hline)
 {
-  _redraw_type = "label";
+  _damage = DAMAGE_LABEL;
   _item_type = "Label";
   _color_idx = -1;
   _selectable = selectable;
@@ -91,7 +92,7 @@ void Label::draw(int y_offset, bool force, bool highlight)
 
   wmove(_win, _posy-y_offset, _posx);
 
-  if (_redraw_type != "label") { return; }
+  if (! (_damage & DAMAGE_LABEL)) { return; }
 
   if (highlight && _selectable)
   {
@@ -116,7 +117,7 @@ void Label::draw(int y_offset, bool force, bool highlight)
   if ( (_bold) && (! colors.pairIsBold(_color_idx)) )
     wattroff(_win, A_BOLD);
 
-  wrefresh(_win);
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -140,7 +141,7 @@ std::string Label::exec(int y_offset, MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: return Enter signal
 
@@ -12,6 +12,7 @@
 #include "AbstractListBox.h"
 #include "ListBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -332,13 +333,15 @@ void ListBox::redrawScrollIndicator() const
 
 /*******************************************************************************
 
-Redraws the previously and currently highlighted items
+Redraws marked items and the previously and currently highlighted items
 
 *******************************************************************************/
 void ListBox::redrawChangedItems()
 {
   int rows, cols, rowsavail;
 
+  AbstractListBox::redrawChangedItems();
+
   getmaxyx(_win, rows, cols);
   rowsavail = rows-_reserved_rows;
 
@@ -390,7 +393,8 @@ void ListBox::removeItem(unsigned int idx)
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 void ListBox::clearList()
@@ -399,7 +403,8 @@ void ListBox::clearList()
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 /*******************************************************************************
@@ -407,19 +412,26 @@ void ListBox::clearList()
 Set attributes
 
 *******************************************************************************/
-void ListBox::setActivated(bool activated) { _activated = activated; }
+void ListBox::setActivated(bool activated)
+{
+  if (activated != _activated) { itemChanged(_highlight); }
+  _activated = activated;
+}
+
 int ListBox::setHighlight(int highlight)
 {
   if ( (highlight >= 0) && (highlight < int(_items.size())) )
   {
     _prevhighlight = _highlight;
     _highlight = highlight;
-    determineFirstPrint();
+    if (determineFirstPrint() == 1) { _damage |= DAMAGE_SCROLLED; }
+    else { _damage |= DAMAGE_CHANGED; }
     return 0;
   }
   else if (highlight >= int(_items.size()))
   {
-    highlightLast();
+    if (highlightLast() == 1) { _damage |= DAMAGE_SCROLLED; }
+    else { _damage |= DAMAGE_CHANGED; }
     return 1;
   }
   else { return 1; }
@@ -516,8 +528,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
 
           // Redraw and pause for .1 seconds to make button selection visible
 
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           draw();
+          frame_scheduler.update();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -541,9 +554,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightPreviousPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _damage |= DAMAGE_SCROLLED;
           else
-            _redraw_type = "changed";
+            _damage |= DAMAGE_CHANGED;
           return signals::highlight;
         }
         else
@@ -555,9 +568,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = highlightNextPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
+            _damage |= DAMAGE_SCROLLED;
           else
-            _redraw_type = "changed";
+            _damage |= DAMAGE_CHANGED;
           return signals::highlight;
         }
         else
@@ -569,9 +582,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
                double(rowsavail-1);
         check_redraw = highlightFractional(frac);
         if (check_redraw == 1)
-          _redraw_type = "all";
+          _damage |= DAMAGE_SCROLLED;
         else
-          _redraw_type = "changed";
+          _damage |= DAMAGE_CHANGED;
         return signals::highlight;
       }
     }
@@ -588,9 +601,9 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
       _prevhighlight = _highlight;
       _highlight = _firstprint + (ycurs - _header_rows);
       if (determineFirstPrint() == 1)
-        _redraw_type = "all";
+        _damage |= DAMAGE_SCROLLED;
       else
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
 
       if (mevent->button() == 3)
         return signals::tag;
@@ -610,18 +623,18 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
   {
     check_redraw = highlightPreviousPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _damage |= DAMAGE_SCROLLED;
     else
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
     return signals::highlight;
   }
   else if (mevent->button() == 5)
   {
     check_redraw = highlightNextPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
+      _damage |= DAMAGE_SCROLLED;
     else
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
     return signals::highlight;
   }
   else
@@ -630,34 +643,6 @@ std::string ListBox::handleMouseEvent(MouseEvent * mevent)
 
 /*******************************************************************************
 
-Draws list box (frame, items, etc.) as needed
-
-*******************************************************************************/
-void ListBox::draw(bool force)
-{
-  if (force) { _redraw_type = "all"; }
-
-  // Draw list elements
-
-  if (_redraw_type == "all")
-  { 
-    clearWindow(); 
-    colors.setBackground(_win, _fg_color, _bg_color);
-  }
-  if (_redraw_type == "buttons") { redrawButtons(); }
-  else if (_redraw_type != "none") 
-  {
-    redrawFrame();
-    redrawScrollIndicator();
-  }
-  if ( (_redraw_type == "all") || (_redraw_type == "items")) { 
-                                                            redrawAllItems(); }
-  else if (_redraw_type == "changed") { redrawChangedItems(); }
-  wrefresh(_win);
-}
-
-/*******************************************************************************
-
 User interaction: returns key stroke or other signal
 
 *******************************************************************************/
@@ -680,7 +665,7 @@ std::string ListBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: accept selection
 
@@ -691,14 +676,14 @@ std::string ListBox::exec(MouseEvent * mevent)
         retval = _button_signals[_highlighted_button];
       else
         retval = signals::keyEnter;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Tab key: return keyTab
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
@@ -706,38 +691,38 @@ std::string ListBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::highlight;
       check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_DOWN:
       retval = signals::highlight;
       check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_PPAGE:
       retval = signals::highlight;
       check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_NPAGE:
       retval = signals::highlight;
       check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     // Right/Left: change highlighted button
@@ -745,29 +730,27 @@ std::string ListBox::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      if (check_redraw == 1) { _redraw_type = "buttons"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      if (check_redraw == 1) { _redraw_type = "buttons"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
       break;
 
     // Resize signal
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Mouse
@@ -776,7 +759,7 @@ std::string ListBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
         retval = signals::mouseEvent;
       }
       else
@@ -785,7 +768,6 @@ std::string ListBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
       break;
   }
   return retval;
@@ -101,7 +101,7 @@ void ListItem::setPropByIdx(unsigned int idx, const std::string & value)
 
 /*******************************************************************************
 
-Constructors
+Constructors and destructor
 
 *******************************************************************************/
 ListItem::ListItem() 
@@ -118,6 +118,8 @@ ListItem::ListItem(const std::string & name)
   _hotkey = -1;
 }
 
+ListItem::~ListItem() {}
+
 /*******************************************************************************
 
 Set properties. Methods with return value return 0 for success or 1 for failure.
@@ -4,6 +4,10 @@
 #include <cmath>      // floor
 #include <curses.h>
 #include <stdlib.h>   // exit, EXIT_SUCCESS
+#include <set>
+#include <poll.h>
+#include <unistd.h>   // STDIN_FILENO
+#include <sys/inotify.h>
 #include "Color.h"
 #include "settings.h"
 #include "string_util.h"
@@ -31,13 +35,22 @@
 #include "PackageInfoBox.h"
 #include "MainWindow.h"
 #include "MouseEvent.h"
+#include "FileWatcher.h"
+#include "DependencyGraph.h"   // dependency_graph
+#include "FrameScheduler.h"
+
+#ifndef PACKAGE_DIR
+  #define PACKAGE_DIR "/var/lib/pkgtools/packages"
+#endif
 
 /*******************************************************************************
 
-Prints/clears status message
+Prints/clears status message. Status messages are shown right away, since they
+often announce work that takes a while. refreshStatus only redraws the message
+as part of redrawing the window.
 
 *******************************************************************************/
-void MainWindow::printStatus(const std::string & msg, bool bold)
+void MainWindow::redrawStatus(const std::string & msg, bool bold)
 {
   int rows, cols;
 
@@ -48,7 +61,13 @@ void MainWindow::printStatus(const std::string & msg, bool bold)
   printToEol(msg, cols);
   if (bold) { attroff(A_BOLD); }
   _status = msg;
-  refresh();
+  frame_scheduler.schedule(stdscr);
+}
+
+void MainWindow::printStatus(const std::string & msg, bool bold)
+{
+  redrawStatus(msg, bold);
+  frame_scheduler.update();
 }
 
 void MainWindow::clearStatus()
@@ -59,17 +78,18 @@ void MainWindow::clearStatus()
   move(rows-2, 0);
   clrtoeol();
   _status = "";
-  refresh();
+  frame_scheduler.schedule(stdscr);
+  frame_scheduler.update();
 }
 
-void MainWindow::refreshStatus() { printStatus(_status); }
+void MainWindow::refreshStatus() { redrawStatus(_status); }
 
 /*******************************************************************************
 
 Redraws header and footer
 
 *******************************************************************************/
-void MainWindow::redrawHeaderFooter()
+void MainWindow::redrawHeaderFooter(bool force)
 {
   int rows, cols, namelen, left;
   double mid;
@@ -78,7 +98,7 @@ void MainWindow::redrawHeaderFooter()
 
   // Draw menubar
 
-  _menubar.draw();
+  _menubar.draw(force);
 
   // Print filter selection
 
@@ -98,7 +118,7 @@ void MainWindow::redrawHeaderFooter()
   printToEol(_info, cols-(left-1));
   colors.turnOff(stdscr);
 
-  refresh();
+  frame_scheduler.schedule(stdscr);
 }
 
 /*******************************************************************************
@@ -161,10 +181,10 @@ void MainWindow::redrawWindowsVert()
 
 /*******************************************************************************
 
-Redraws windows
+Places windows according to the layout and screen size
 
 *******************************************************************************/
-void MainWindow::redrawWindows(bool force)
+void MainWindow::placeWindows()
 {
   // "Resetting" the windows like this before placing them seems to help avoid
   // some weird behavior (e.g., with toggleLayout not placing _win2 in the right
@@ -175,13 +195,17 @@ void MainWindow::redrawWindows(bool force)
   mvwin(_win2, 0, 0);
   wresize(_win2, 1, 1);
 
-  // Set up windows
-
   if (settings::layout == "vertical") { redrawWindowsVert(); }
   else { redrawWindowsHorz(); }
+}
+
+/*******************************************************************************
 
-  // Redraw windows
+Redraws windows
 
+*******************************************************************************/
+void MainWindow::redrawWindows(bool force)
+{
   _clistbox.draw(force);
   _blistboxes[_category_idx].draw(force);
 }
@@ -206,14 +230,18 @@ Clears windows, data, etc.
 *******************************************************************************/
 void MainWindow::clearData()
 {
+  _watcher.stop();
+  dependency_graph.clear();
   if (_win1) { delwin(_win1); }
   if (_win2) { delwin(_win2); }
   _blistboxes.resize(0);
   _slackbuilds.resize(0);
-  _displayed_slackbuilds.resize(0);
   _categories.resize(0);
-  _displayed_categories.resize(0);
+  _build_index.clear();
+  _displayed.resize(0);
+  _filtered.resize(0);
   _taglist.clearList();
+  _fuzzy_index.clear();
   _category_idx = 0;
   _activated_listbox = 0;
 }
@@ -246,8 +274,9 @@ int MainWindow::readLists(MouseEvent * mevent, bool interactive)
     _categories.push_back(citem);
   }
 
-  // Create filtered list to display
+  // Number SlackBuilds for filtering and display all of them
 
+  _build_index.create(_slackbuilds);
   resetDisplayedSlackBuilds();
 
   // Determine which are installed and get other info
@@ -310,6 +339,7 @@ void MainWindow::clearTags()
   {
     build = static_cast<BuildListItem *>(_taglist.taggedByIdx(k));
     build->setBoolProp("tagged", false);
+    _build_index.update(build);
   }
   _taglist.clearList();
 
@@ -379,28 +409,12 @@ void MainWindow::rebuild(MouseEvent * mevent)
 
 /*******************************************************************************
 
-Resets displayed slackbuilds and categories lists
+Resets the displayed set to all SlackBuilds
 
 *******************************************************************************/
 void MainWindow::resetDisplayedSlackBuilds()
 {
-  unsigned int i, j, nbuilds, ncategories;
-
-  _displayed_slackbuilds.clear();
-  _displayed_categories.clear();
-  ncategories = _slackbuilds.size();
-  _displayed_slackbuilds.resize(ncategories);
-  _displayed_categories.resize(ncategories);
-  for ( i = 0; i < ncategories; i++ )
-  {
-    _displayed_categories[i] = &_categories[i];
-    nbuilds = _slackbuilds[i].size();
-    _displayed_slackbuilds[i].resize(nbuilds);
-    for ( j = 0; j < nbuilds; j++ )
-    {
-      _displayed_slackbuilds[i][j] = &_slackbuilds[i][j];
-    }
-  }
+  _displayed.resize(_build_index.size(), true);
 }
 
 /*******************************************************************************
@@ -423,7 +437,6 @@ void MainWindow::filterAll(MouseEvent * mevent)
 {
   unsigned int nbuilds;
   std::string choice;
-  bool (*func)(const BuildListItem &);
 
   _filter = "all SlackBuilds";
   printStatus("Filtering by all SlackBuilds ...");
@@ -432,9 +445,10 @@ void MainWindow::filterAll(MouseEvent * mevent)
   _category_idx = 0;
 
   resetDisplayedSlackBuilds();
-  func = &any_build;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, nbuilds, settings::cumulative_filters);
+  _build_index.refresh();
+  _filtered = _displayed;
+  filter_by_mask(_build_index, _filtered, _categories, _win2, _clistbox,
+                 _blistboxes, nbuilds);
 
   if (nbuilds == 0)
   {
@@ -460,7 +474,6 @@ void MainWindow::filterInstalled()
 {
   unsigned int ninstalled;
   std::vector<std::string> pkg_errors, missing_info;
-  bool (*func)(const BuildListItem &);
   std::string msg;
 
   _filter = "installed SlackBuilds";
@@ -469,9 +482,9 @@ void MainWindow::filterInstalled()
   _activated_listbox = 0;
   _category_idx = 0;
 
-  func = &build_is_installed;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, ninstalled, settings::cumulative_filters);
+  filter_by_status(_build_index, STATUS_INSTALLED, _displayed, _filtered,
+                   _categories, _win2, _clistbox, _blistboxes, ninstalled,
+                   settings::cumulative_filters);
 
   if (ninstalled == 0) 
     msg = "No installed SlackBuilds";
@@ -497,7 +510,6 @@ void MainWindow::filterUpgradable()
 {
   unsigned int nupgradable;
   std::vector<std::string> pkg_errors, missing_info;
-  bool (*func)(const BuildListItem &);
   std::string msg;
 
   _filter = "upgradable SlackBuilds";
@@ -507,9 +519,9 @@ void MainWindow::filterUpgradable()
   _activated_listbox = 0;
   nupgradable = 0;
 
-  func = &build_is_upgradable;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, nupgradable, settings::cumulative_filters);
+  filter_by_status(_build_index, STATUS_UPGRADABLE, _displayed, _filtered,
+                   _categories, _win2, _clistbox, _blistboxes, nupgradable,
+                   settings::cumulative_filters);
 
   if (nupgradable == 0) 
     msg = "No upgradable SlackBuilds";
@@ -534,7 +546,6 @@ Displays tagged SlackBuilds
 void MainWindow::filterTagged()
 {
   unsigned int ntagged;
-  bool (*func)(const BuildListItem &);
   std::string msg;
 
   _filter = "tagged SlackBuilds";
@@ -544,9 +555,9 @@ void MainWindow::filterTagged()
   _activated_listbox = 0;
   ntagged = 0;
 
-  func = &build_is_tagged;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, ntagged, settings::cumulative_filters);
+  filter_by_status(_build_index, STATUS_TAGGED, _displayed, _filtered,
+                   _categories, _win2, _clistbox, _blistboxes, ntagged,
+                   settings::cumulative_filters);
 
   if (ntagged == 0) 
     msg = "No tagged SlackBuilds";
@@ -571,7 +582,6 @@ Displays blacklisted SlackBuilds
 void MainWindow::filterBlacklisted()
 {
   unsigned int nblacklisted;
-  bool (*func)(const BuildListItem &);
   std::string msg;
 
   _filter = "blacklisted SlackBuilds";
@@ -581,9 +591,9 @@ void MainWindow::filterBlacklisted()
   _activated_listbox = 0;
   nblacklisted = 0;
 
-  func = &build_is_blacklisted;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, nblacklisted, settings::cumulative_filters);
+  filter_by_status(_build_index, STATUS_BLACKLISTED, _displayed, _filtered,
+                   _categories, _win2, _clistbox, _blistboxes, nblacklisted,
+                   settings::cumulative_filters);
 
   if (nblacklisted == 0) 
     msg = "No blacklisted SlackBuilds";
@@ -619,8 +629,9 @@ void MainWindow::filterNonDeps()
   _activated_listbox = 0;
   nnondeps = 0;
 
-  filter_nondeps(_slackbuilds, _displayed_slackbuilds, _displayed_categories,
-                 _win2, _clistbox, _blistboxes, nnondeps, settings::cumulative_filters);
+  filter_nondeps(_slackbuilds, _build_index, _displayed, _filtered,
+                 _categories, _win2, _clistbox, _blistboxes, nnondeps,
+                 settings::cumulative_filters);
 
   if (nnondeps == 0) 
     msg = "No non-dependencies";
@@ -645,7 +656,6 @@ Displays SlackBuilds with build options set
 void MainWindow::filterBuildOptions()
 {
   unsigned int nbuildsopts;
-  bool (*func)(const BuildListItem &);
   std::string msg;
 
   _filter = "SlackBuilds with build options set";
@@ -655,9 +665,9 @@ void MainWindow::filterBuildOptions()
   _activated_listbox = 0;
   nbuildsopts = 0;
 
-  func = &build_has_buildoptions;
-  filter_by_func(_displayed_slackbuilds, func, _displayed_categories, _win2,
-                 _clistbox, _blistboxes, nbuildsopts, settings::cumulative_filters);
+  filter_by_status(_build_index, STATUS_BUILDOPTIONS, _displayed, _filtered,
+                   _categories, _win2, _clistbox, _blistboxes, nbuildsopts,
+                   settings::cumulative_filters);
 
   if (nbuildsopts == 0) 
     msg = "No SlackBuilds with build options set";
@@ -676,6 +686,31 @@ void MainWindow::filterBuildOptions()
 
 /*******************************************************************************
 
+Prints the number of search matches as status, saying whether the current
+list or the whole repository was searched
+
+*******************************************************************************/
+void MainWindow::printSearchResult(unsigned int nsearch,
+                                   const std::string & searchterm,
+                                   bool current_list)
+{
+  std::string msg;
+
+  if (nsearch == 0) 
+    msg = "No matches for " + searchterm;
+  else if (nsearch == 1) 
+    msg = "1 match for " + searchterm;
+  else 
+    msg = int_to_string(nsearch) + " matches for " + searchterm;
+  if (current_list)
+    msg += " in current list.";
+  else
+    msg += " in repository.";
+  printStatus(msg);
+}
+
+/*******************************************************************************
+
 Filters SlackBuilds by search term
 
 *******************************************************************************/
@@ -684,7 +719,6 @@ void MainWindow::filterSearch(const std::string & searchterm,
                               bool search_readmes)
 {
   unsigned int nsearch;
-  std::string msg;
 
   _filter = "search for " + searchterm;
   if (search_readmes)
@@ -696,21 +730,39 @@ void MainWindow::filterSearch(const std::string & searchterm,
   _category_idx = 0;
   nsearch = 0;
 
-  filter_search(_displayed_slackbuilds, _displayed_categories, _win2, _clistbox,
-                _blistboxes, nsearch, searchterm, case_sensitive, whole_word,
-                search_readmes, settings::cumulative_filters);
+  filter_search(_build_index, _displayed, _filtered, _categories, _win2,
+                _clistbox, _blistboxes, nsearch, searchterm, case_sensitive,
+                whole_word, search_readmes, settings::cumulative_filters);
 
-  if (nsearch == 0) 
-    msg = "No matches for " + searchterm;
-  else if (nsearch == 1) 
-    msg = "1 match for " + searchterm;
-  else 
-    msg = int_to_string(nsearch) + " matches for " + searchterm;
-  if (_searchbox.currentList())
-    msg += " in current list.";
-  else
-    msg += " in repository.";
-  printStatus(msg);
+  printSearchResult(nsearch, searchterm, _searchbox.currentList());
+
+  setTagList();
+}
+
+/*******************************************************************************
+
+Filters SlackBuilds by fuzzy search of names and short descriptions. The index
+is created the first time it is needed after the lists are read.
+
+*******************************************************************************/
+void MainWindow::filterFuzzy(const std::string & searchterm)
+{
+  unsigned int nsearch;
+
+  _filter = "search for " + searchterm;
+  printStatus("Fuzzy searching for " + searchterm + " ...");
+
+  if (! _fuzzy_index.ready()) { _fuzzy_index.create(_slackbuilds); }
+
+  _activated_listbox = 0;
+  _category_idx = 0;
+  nsearch = 0;
+
+  filter_fuzzy(_build_index, _displayed, _filtered, _categories, _fuzzy_index,
+               _win2, _clistbox, _blistboxes, nsearch, searchterm,
+               settings::cumulative_filters);
+
+  printSearchResult(nsearch, searchterm, _searchbox.currentList());
 
   setTagList();
 }
@@ -728,7 +780,7 @@ int MainWindow::showOptions(MouseEvent * mevent)
   int check_color, check_write;
 
   clear();
-  refresh();
+  frame_scheduler.schedule(stdscr);
 
   optionswin = newwin(1, 1, 0, 0);
   _options.setWindow(optionswin);
@@ -746,7 +798,7 @@ int MainWindow::showOptions(MouseEvent * mevent)
     else if (selection == signals::resize) 
     { 
       clear();
-      refresh();
+      frame_scheduler.schedule(stdscr);
       _options.placeWindow();
     }
     else if (selection == "q") { return 1; }
@@ -822,7 +874,7 @@ int MainWindow::showHelp(MouseEvent * mevent, bool mouse_help)
   HelpWindow *help;
 
   clear();
-  refresh();
+  frame_scheduler.schedule(stdscr);
 
   helpwin = newwin(1, 1, 0, 0);
   if (mouse_help)
@@ -843,7 +895,7 @@ int MainWindow::showHelp(MouseEvent * mevent, bool mouse_help)
     else if (selection == signals::resize) 
     { 
       clear();
-      refresh();
+      frame_scheduler.schedule(stdscr);
       help->placeWindow();
     }
     else if (selection == "q") { return 1; }
@@ -878,6 +930,69 @@ void MainWindow::setTagList()
 
 /*******************************************************************************
 
+Reports problems creating a build order (return value of InstallBox::create).
+what is added after "dependencies" in the message, e.g. " of <name>". Returns
+1 if the build order cannot be used, 0 otherwise.
+
+*******************************************************************************/
+int MainWindow::reportPlanProblems(int check, const std::string & what,
+                                   MouseEvent * mevent)
+{
+  if (check == 1) 
+  { 
+    clearStatus();
+    displayError("Unable to find one or more dependencies" + what +
+                 std::string(" in repository. Build order may be incomplete."),
+                 true, "Warning", "Ok", mevent);
+  }
+  else if (check == 2)
+  { 
+    clearStatus();
+    displayError("A .info file seems to be missing from the repository, so " +
+                 std::string("build order is incomplete. Syncing may fix ") +
+                 std::string("this problem."), true, "Error", "Ok", mevent);
+    return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Describes number of dependencies and inverse dependencies in a build order
+
+*******************************************************************************/
+std::string MainWindow::describeDeps(int ndeps, unsigned int ninvdeps,
+                                     const std::string & action) const
+{
+  std::string deptxt, invdeptxt;
+
+  if (ndeps == 1)
+  { 
+    if (action == "Remove")
+      deptxt = "1 installed dependency";
+    else
+      deptxt = "1 dependency";
+  }
+  else
+  { 
+    if (action == "Remove")
+      deptxt = int_to_string(ndeps) + " installed dependencies";
+    else
+      deptxt = int_to_string(ndeps) + " dependencies";
+  }
+
+  invdeptxt = "";
+  if (ninvdeps == 1)
+    invdeptxt = " and 1 inverse dependency";
+  else if (ninvdeps > 1)
+    invdeptxt = " and " + int_to_string(ninvdeps) + " inverse dependencies";
+
+  return deptxt + invdeptxt;
+}
+
+/*******************************************************************************
+
 Installs/upgrades/reinstalls/removes SlackBuild and dependencies. Returns true
 if anything was changed, false otherwise.
 
@@ -888,14 +1003,8 @@ bool MainWindow::modifyPackage(BuildListItem & build,
                                int & nremoved, bool & cancel_all, bool batch,
                                MouseEvent * mevent)
 {
-  WINDOW *installerwin;
-  int check, nchanged_orig, nchanged_new, response, ndeps;
-  std::string selection, msg, choice, deptxt, invdeptxt;
-  bool getting_input, needs_rebuild;
-  unsigned int i, ninvdeps, nforeign;
-  std::vector<const BuildListItem *> foreign;
+  int check;
   InstallBox installer;
-  BuildListItem *subbuild;
 
   if (settings::resolve_deps)
     printStatus("Computing dependencies for " + build.name() + " ...");
@@ -903,58 +1012,88 @@ bool MainWindow::modifyPackage(BuildListItem & build,
                            batch, settings::rebuild_inv_deps);
   installer.setTagList(&_taglist);
 
-  if (check == 1) 
-  { 
-    clearStatus();
-    displayError("Unable to find one or more dependencies of " + build.name() +
-                 std::string(" in repository. Build order may be incomplete."),
-                 true, "Warning", "Ok", mevent);
-  }
-  else if (check == 2)
-  { 
-    clearStatus();
-    displayError("A .info file seems to be missing from the repository, so " +
-                 std::string("build order is incomplete. Syncing may fix ") +
-                 std::string("this problem."), true, "Error", "Ok", mevent);
+  if (reportPlanProblems(check, " of " + build.name(), mevent) != 0)
     return false;
-  }
 
-  ndeps = installer.numDeps();
-  ninvdeps = installer.numInvDeps();
-  deptxt = "";
-  invdeptxt = "";
   if (settings::resolve_deps)
   {
     /* The list can possibly be empty when removing tagged SlackBuilds.
        In this case, there's nothing left to do. */
-    if (ndeps < 0)
+    if (installer.numDeps() < 0)
     {
       clearStatus();
       return false;
     }
+    printStatus(describeDeps(installer.numDeps(), installer.numInvDeps(),
+                             action) + " for " + build.name() + ".");
+  }
 
-    if (ndeps == 1)
-    { 
-      if (action == "Remove")
-        deptxt = "1 installed dependency";
-      else
-        deptxt = "1 dependency";
-    }
-    else if (ndeps >= 0)
-    { 
-      if (action == "Remove")
-        deptxt = int_to_string(ndeps) + " installed dependencies";
-      else
-        deptxt = int_to_string(ndeps) + " dependencies";
-    }
-    if (ninvdeps == 1)
-      invdeptxt = " and 1 inverse dependency";
-    else if (ninvdeps > 1)
-      invdeptxt = " and " + int_to_string(ninvdeps) + " inverse dependencies";
+  return confirmAndApply(installer, ninstalled, nupgraded, nreinstalled,
+                         nremoved, cancel_all, batch, mevent);
+}
+
+/*******************************************************************************
 
-    printStatus(deptxt + invdeptxt + " for " + build.name() + ".");
+Installs/upgrades/reinstalls/removes several SlackBuilds and their dependencies
+at once, using a single merged build order. Returns true if anything was
+changed, false otherwise.
+
+*******************************************************************************/
+bool MainWindow::modifyPackages(const std::vector<BuildListItem *> & builds,
+                                const std::string & action, int & ninstalled,
+                                int & nupgraded, int & nreinstalled,
+                                int & nremoved, MouseEvent * mevent)
+{
+  int check;
+  bool cancel_all;
+  InstallBox installer;
+
+  if (settings::resolve_deps)
+    printStatus("Computing dependencies for " + int_to_string(builds.size()) +
+                " SlackBuilds ...");
+  check = installer.create(builds, _slackbuilds, action, settings::resolve_deps,
+                           settings::rebuild_inv_deps);
+  installer.setTagList(&_taglist);
+
+  if (reportPlanProblems(check, "", mevent) != 0) { return false; }
+
+  if (settings::resolve_deps)
+  {
+    // The list can be empty when removing tagged SlackBuilds
+
+    if (installer.numDeps() < 0)
+    {
+      clearStatus();
+      return false;
+    }
+    printStatus(describeDeps(installer.numDeps(), installer.numInvDeps(),
+                             action) + " for " + int_to_string(builds.size()) +
+                " SlackBuilds.");
   }
 
+  return confirmAndApply(installer, ninstalled, nupgraded, nreinstalled,
+                         nremoved, cancel_all, true, mevent);
+}
+
+/*******************************************************************************
+
+Shows the changes in an InstallBox for confirmation (if enabled in settings)
+and applies them. Returns true if anything was changed, false otherwise.
+
+*******************************************************************************/
+bool MainWindow::confirmAndApply(InstallBox & installer, int & ninstalled,
+                                 int & nupgraded, int & nreinstalled,
+                                 int & nremoved, bool & cancel_all, bool batch,
+                                 MouseEvent * mevent)
+{
+  WINDOW *installerwin;
+  int check, nchanged_orig, nchanged_new, response;
+  std::string selection, msg, choice;
+  bool getting_input, needs_rebuild;
+  unsigned int i, nforeign;
+  std::vector<const BuildListItem *> foreign;
+  BuildListItem *subbuild;
+
   // Show list of changes to apply and/or apply changes
 
   needs_rebuild = false;
@@ -1024,7 +1163,11 @@ bool MainWindow::modifyPackage(BuildListItem & build,
         draw(true);
       }
       else if (selection == signals::tag)
+      {
         installer.tagHighlightedSlackBuild();
+        _build_index.update(
+                    static_cast<BuildListItem *>(installer.highlightedItem()));
+      }
     }
     delwin(installerwin);
   }
@@ -1041,6 +1184,8 @@ bool MainWindow::modifyPackage(BuildListItem & build,
                                    nremoved);
     nchanged_new = ninstalled + nupgraded + nreinstalled + nremoved;
     if (nchanged_new > nchanged_orig) { needs_rebuild = true; }
+    dependency_graph.installedChanged();
+    _build_index.invalidate();
     reset_prog_mode();
     draw(true);
     if (check != 0)
@@ -1088,6 +1233,7 @@ void MainWindow::setBuildOptions(BuildListItem & build, MouseEvent * mevent)
     {
       getting_input = false;
       build.setProp("build_options", buildoptions.entries());
+      _build_index.update(&build);
       if (settings::save_buildopts)
       {
         check = buildoptions.write(build);
@@ -1209,7 +1355,11 @@ void MainWindow::showBuildOrder(BuildListItem & build, const std::string & mode,
       need_selection = false;
     }
     else if (selection == signals::tag)
+    {
       buildorder.tagHighlightedSlackBuild();
+      _build_index.update(
+                  static_cast<BuildListItem *>(buildorder.highlightedItem()));
+    }
   }
 
   clearStatus();
@@ -1357,8 +1507,11 @@ int MainWindow::syncRepo(MouseEvent * mevent)
 
   if (check == 0) 
   {
-    clearData();
-    initialize();
+    if (updateFromSync(mevent) != 0)
+    {
+      clearData();
+      initialize();
+    }
   }
   else { displayError("An error occurred while trying to sync.", true, "Error",
                       "Ok", mevent); }
@@ -1368,6 +1521,226 @@ int MainWindow::syncRepo(MouseEvent * mevent)
 
 /*******************************************************************************
 
+Updates only the SlackBuilds changed by the last sync, as recorded by sync_repo.
+Returns 0 on success, or 1 if everything must be read again instead: no record
+of the changes, or SlackBuilds were added or removed.
+
+*******************************************************************************/
+int MainWindow::updateFromSync(MouseEvent * mevent)
+{
+  std::vector<std::string> changed;
+  std::vector<BuildListItem *> builds;
+  std::string category, name;
+  std::size_t slashpos;
+  unsigned int k, nchanged;
+  int i, j;
+
+  if (_slackbuilds.size() == 0) { return 1; }
+  if (read_sync_changes(changed) != 0) { return 1; }
+
+  nchanged = changed.size();
+  for ( k = 0; k < nchanged; k++ )
+  {
+    slashpos = changed[k].find('/');
+    category = changed[k].substr(0, slashpos);
+    name = changed[k].substr(slashpos+1);
+    if (find_slackbuild(name, _slackbuilds, i, j) != 0) { return 1; }
+    if (_slackbuilds[i][j].category() != category) { return 1; }
+    if (RepoIndex::dirMtime(settings::repo_dir + "/" + changed[k]) == -1)
+      return 1;
+    builds.push_back(&_slackbuilds[i][j]);
+  }
+
+  // The repository index was updated by the sync, so this is fast
+
+  for ( k = 0; k < nchanged; k++ )
+  {
+    builds[k]->readPropsFromRepo();
+    _build_index.update(builds[k]);
+  }
+  if (nchanged > 0)
+  {
+    dependency_graph.clear();
+    _fuzzy_index.clear();
+    rebuild(mevent);
+  }
+  else { draw(true); }
+
+  if (nchanged == 1)
+    printStatus("Sync complete: 1 SlackBuild changed.");
+  else
+    printStatus("Sync complete: " + int_to_string(nchanged) +
+                " SlackBuilds changed.");
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Starts watching the installed packages directory and the repository for
+changes. The repository is watched at three levels: repo_dir and category
+directories, to detect SlackBuilds being added or removed, and SlackBuild
+directories, to detect changed .info and .SlackBuild files. If the system limit
+on inotify watches is reached, the remaining SlackBuilds are not watched.
+
+*******************************************************************************/
+void MainWindow::startWatching()
+{
+  unsigned int i, j, ncategories, nbuilds;
+  uint32_t pkgmask, dirmask, filemask;
+  std::string catdir;
+  bool watch_builds;
+
+  if (_watcher.start() != 0) { return; }
+
+  pkgmask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_CLOSE_WRITE;
+  dirmask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+  filemask = IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_TO;
+
+  _watcher.addWatch(PACKAGE_DIR, pkgmask);
+  _watcher.addWatch(settings::repo_dir, dirmask);
+
+  watch_builds = true;
+  ncategories = _slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    catdir = settings::repo_dir + "/" + _slackbuilds[i][0].category();
+    _watcher.addWatch(catdir, dirmask);
+    nbuilds = _slackbuilds[i].size();
+    for ( j = 0; (j < nbuilds) && watch_builds; j++ )
+    {
+      if (_watcher.addWatch(catdir + "/" + _slackbuilds[i][j].name(),
+                            filemask) != 0) { watch_builds = false; }
+    }
+  }
+}
+
+/*******************************************************************************
+
+Handles pending file change notifications. Only the affected SlackBuilds are
+updated: installed state is rechecked for changed packages, and repository
+info is reread for SlackBuilds whose files changed.
+
+*******************************************************************************/
+void MainWindow::handleWatchEvents()
+{
+  std::vector<watchevent> events;
+  std::set<std::string> pkgnames, changed_builds;
+  std::set<std::string>::const_iterator it;
+  std::string name, version, arch, build, msg;
+  unsigned int k, nevents;
+  std::size_t slashpos;
+  bool structure_changed;
+  int i, j;
+
+  nevents = _watcher.readEvents(events);
+  if (nevents == 0) { return; }
+
+  // Sort out what changed
+
+  structure_changed = false;
+  for ( k = 0; k < nevents; k++ )
+  {
+    if ( (events[k].name.size() == 0) || (events[k].name[0] == '.') )
+      continue;
+
+    if (events[k].path == PACKAGE_DIR)
+    {
+      if (get_pkg_info(events[k].name, name, version, arch, build) == 0)
+        pkgnames.insert(name);
+    }
+    else if (events[k].mask & IN_ISDIR)
+      structure_changed = true;
+    else if ( (events[k].name.size() > 5) &&
+              ( (events[k].name.substr(events[k].name.size()-5) == ".info") ||
+                (events[k].name.find(".SlackBuild") != std::string::npos) ) )
+    {
+      slashpos = events[k].path.find_last_of('/');
+      changed_builds.insert(events[k].path.substr(slashpos+1));
+    }
+  }
+
+  // Update installed state
+
+  for ( it = pkgnames.begin(); it != pkgnames.end(); it++ )
+  {
+    installed_packages.update(*it);
+    if (find_slackbuild(*it, _slackbuilds, i, j) != 0) { continue; }
+    _slackbuilds[i][j].readInstalledProps();
+    if (_slackbuilds[i][j].installed())
+      _slackbuilds[i][j].readPropsFromRepo();
+    _build_index.update(&_slackbuilds[i][j]);
+  }
+
+  // Reread repository info, bypassing the (now out of date) index
+
+  for ( it = changed_builds.begin(); it != changed_builds.end(); it++ )
+  {
+    if (find_slackbuild(*it, _slackbuilds, i, j) != 0) { continue; }
+    repo_index.forget(_slackbuilds[i][j].category(), *it);
+    _slackbuilds[i][j].readPropsFromRepo();
+    _build_index.update(&_slackbuilds[i][j]);
+  }
+
+  if ( (pkgnames.size() == 0) && (changed_builds.size() == 0) &&
+       (! structure_changed) ) { return; }
+  if (changed_builds.size() > 0) { dependency_graph.clear(); }
+  else { dependency_graph.installedChanged(); }
+
+  redrawWindows(true);
+  if (structure_changed)
+    printStatus("SlackBuilds were added to or removed from the repository. "
+                "Sync or restart to reload.", true);
+  else if (pkgnames.size() > 0)
+    printStatus("Installed packages changed: " + *pkgnames.begin() +
+                (pkgnames.size() > 1 ? " ..." : ""));
+  else
+    printStatus("Repository changed: " + *changed_builds.begin() +
+                (changed_builds.size() > 1 ? " ..." : ""));
+}
+
+/*******************************************************************************
+
+Waits until keyboard or mouse input is available, handling file change
+notifications while waiting. Returns right away if curses already has a key
+queued, and early if interrupted by a signal (e.g., a terminal resize), so that
+curses can process it.
+
+*******************************************************************************/
+void MainWindow::waitForInput()
+{
+  struct pollfd fds[2];
+  int ch;
+
+  // Keys already queued in curses (e.g., from ungetch) would not show up on
+  // stdin, so check for them before polling
+
+  nodelay(stdscr, TRUE);
+  ch = getch();
+  nodelay(stdscr, FALSE);
+  if (ch != ERR)
+  {
+    ungetch(ch);
+    return;
+  }
+
+  fds[0].fd = STDIN_FILENO;
+  fds[0].events = POLLIN;
+  fds[1].fd = _watcher.fd();
+  fds[1].events = POLLIN;
+
+  while (_watcher.active())
+  {
+    frame_scheduler.update();
+    if (poll(fds, 2, -1) == -1) { return; }
+    if (fds[1].revents & POLLIN) { handleWatchEvents(); }
+    if (fds[0].revents != 0) { return; }
+  }
+}
+
+/*******************************************************************************
+
 Applies action to tagged SlackBuilds
 
 *******************************************************************************/
@@ -1376,9 +1749,9 @@ void MainWindow::applyTags(const std::string & action, MouseEvent * mevent)
   WINDOW *tagwin;
   unsigned int ndisplay, i, j, ncategories;
   int ninstalled, nupgraded, nreinstalled, nremoved;
-  bool getting_input, cancel_all, apply_changes, any_modified, needs_rebuild;
+  bool getting_input, apply_changes, needs_rebuild;
   std::string selection;
-  std::vector<bool> marked_list;
+  std::vector<BuildListItem *> selected;
   BuildListItem *build;
 
   ndisplay = _taglist.getDisplayList(action);
@@ -1426,51 +1799,39 @@ void MainWindow::applyTags(const std::string & action, MouseEvent * mevent)
   delwin(tagwin);
   draw(true);
 
-  // Store a list of user selections, because in some cases modifyPackage
-  // may change the "marked" property of a build prior to its turn in the
-  // Apply changes loop below
+  // Collect SlackBuilds selected by the user. The whole selection is planned
+  // and shown at once, so shared dependencies are only resolved once.
 
-  marked_list.resize(ndisplay);
   for ( i = 0; i < ndisplay; i++ )
   {
     build = static_cast<BuildListItem *>(_taglist.itemByIdx(i));
-    marked_list[i] = build->getBoolProp("marked");
+    if (build->getBoolProp("marked")) { selected.push_back(build); }
   }
 
   // Apply changes
 
   needs_rebuild = false;
-  if (apply_changes)
+  if ( (apply_changes) && (selected.size() > 0) )
   {
     ninstalled = 0;
     nupgraded = 0;
     nreinstalled = 0;
     nremoved = 0;
-    for ( i = 0; i < ndisplay; i++ ) 
-    {
-      build = static_cast<BuildListItem *>(_taglist.itemByIdx(i));
-      build->setBoolProp("marked", marked_list[i]);
-      if (marked_list[i])
-      { 
-        any_modified = modifyPackage(*build, action, ninstalled, nupgraded,
-                                     nreinstalled, nremoved, cancel_all, true,
-                                     mevent);
-        if (! needs_rebuild) { needs_rebuild = any_modified; }
+    needs_rebuild = modifyPackages(selected, action, ninstalled, nupgraded,
+                                   nreinstalled, nremoved, mevent);
 
-        // Because tags could have changed, determine if categories should be
-        // tagged
+    // Because tags could have changed, determine if categories should be
+    // tagged
 
-        ncategories = _clistbox.numItems();
-        for ( j = 0; j < ncategories; j++ )
-        {
-          if (_blistboxes[j].allTagged())
-            _clistbox.itemByIdx(j)->setBoolProp("tagged", true);
-          else { _clistbox.itemByIdx(j)->setBoolProp("tagged", false); }
-        }
-        draw(true);
-      }
-      if (cancel_all) { break; }
+    ncategories = _clistbox.numItems();
+    for ( j = 0; j < ncategories; j++ )
+    {
+      if (_blistboxes[j].allTagged())
+        _clistbox.itemByIdx(j)->setBoolProp("tagged", true);
+      else { _clistbox.itemByIdx(j)->setBoolProp("tagged", false); }
     }
+    draw(true);
+
     if (needs_rebuild)
       displayMessage("Summary of applied changes:\n\n"
            + std::string("Installed: ") + int_to_string(ninstalled) + "\n"
@@ -1764,6 +2125,8 @@ void MainWindow::menubarActions(MouseEvent * mevent)
       upgradeAll(mevent);
     else if (entry == "Search")
       search(mevent);
+    else if (entry == "Live search")
+      liveSearch();
   }
   else if (list == "Filter")
   {
@@ -1875,11 +2238,17 @@ void MainWindow::drawSelectedCategory()
 
 void MainWindow::tagSelectedCategory()
 {
+  std::vector<BuildListItem *> builds;
+  unsigned int k, nbuilds;
+
   _category_idx = _clistbox.highlight();
   _clistbox.tagHighlightedCategory();
   _clistbox.draw();
   _blistboxes[_category_idx].tagAll();
-  _blistboxes[_category_idx].draw(true);
+  _blistboxes[_category_idx].draw();
+  _blistboxes[_category_idx].filteredItems(builds);
+  nbuilds = builds.size();
+  for ( k = 0; k < nbuilds; k++ ) { _build_index.update(builds[k]); }
 }
 
 void MainWindow::tagSelectedSlackBuild()
@@ -1887,13 +2256,16 @@ void MainWindow::tagSelectedSlackBuild()
   bool all_tagged;
 
   _blistboxes[_category_idx].tagHighlightedSlackBuild();
+  _build_index.update(static_cast<BuildListItem *>(
+                      _blistboxes[_category_idx].highlightedItem()));
   all_tagged = _blistboxes[_category_idx].allTagged();
   if (_clistbox.highlightedItem()->getBoolProp("tagged"))
   {
     if (! all_tagged) 
     { 
       _clistbox.highlightedItem()->setBoolProp("tagged", false);
-      _clistbox.draw(true);
+      _clistbox.itemChanged(_clistbox.highlight());
+      _clistbox.draw();
     }
   }
   else 
@@ -1901,7 +2273,8 @@ void MainWindow::tagSelectedSlackBuild()
     if (all_tagged) 
     { 
       _clistbox.highlightedItem()->setBoolProp("tagged", true);
-      _clistbox.draw(true);
+      _clistbox.itemChanged(_clistbox.highlight());
+      _clistbox.draw();
     }
   }
 }
@@ -1939,15 +2312,16 @@ MainWindow::MainWindow(const std::string & version)
   _win2 = NULL;
   _blistboxes.resize(0);
   _slackbuilds.resize(0);
-  _displayed_slackbuilds.resize(0);
   _categories.resize(0);
-  _displayed_categories.resize(0);
   _filter = "all SlackBuilds";
   _info = "s: Sync | f: Filter | /: Search | o: Options | F9: Menu";
   _status = "";
   _conf_file = "";
   _category_idx = 0;
   _activated_listbox = 0;
+  _screen_rows = 0;
+  _screen_cols = 0;
+  _screen_layout = "";
   setWindow(stdscr);
 
   // Set up menubar
@@ -1965,6 +2339,7 @@ MainWindow::MainWindow(const std::string & version)
   _menubar.addListItem("Actions", "Sync", "s", 0);
   _menubar.addListItem("Actions", "Upgrade all", "Ctrl-u", 0);
   _menubar.addListItem("Actions", "Search", "/", 1);
+  _menubar.addListItem("Actions", "Live search", "Ctrl-f", 0);
 
   _menubar.addList("Filter", 2);
   _menubar.addListItem("Filter", "All", "", 0);
@@ -2001,10 +2376,11 @@ int MainWindow::initialize(MouseEvent * mevent)
   int retval;
   std::string msg;
 
-  // Create windows (note: geometry gets set in redrawWindows);
+  // Create windows (note: geometry gets set in placeWindows);
 
   _win1 = newwin(1, 1, 0, 0);
   _win2 = newwin(1, 1, 0, 0);
+  _screen_rows = 0;
 
   _clistbox.clearList();
   _clistbox.setWindow(_win1);
@@ -2047,6 +2423,7 @@ int MainWindow::initialize(MouseEvent * mevent)
     msg += "type 's' to sync the local repository.";
     displayError(msg, true, "Error", "Ok", mevent);
   }
+  if ( (retval == 0) && settings::watch_files ) { startWatching(); }
   draw(true);
 
   return retval;
@@ -2173,8 +2550,11 @@ void MainWindow::search(MouseEvent * mevent)
         if (! _searchbox.currentList()) filterAll(mevent);
 
         // Now do the search
-        filterSearch(_searchbox.searchString(), _searchbox.caseSensitive(),
-                     _searchbox.wholeWord(), _searchbox.searchREADMEs());
+        if (_searchbox.fuzzyMatch())
+          filterFuzzy(_searchbox.searchString());
+        else
+          filterSearch(_searchbox.searchString(), _searchbox.caseSensitive(),
+                       _searchbox.wholeWord(), _searchbox.searchREADMEs());
       }
     }
     else if (selection == signals::quit) { getting_input = false; }
@@ -2391,6 +2771,128 @@ void MainWindow::quickSearch()
 
 /*******************************************************************************
 
+Puts back the lists saved when a live search was started
+
+*******************************************************************************/
+void MainWindow::restoreLists(const std::vector<BuildListBox> & blistboxes,
+                              const std::vector<ListItem *> & categories)
+{
+  unsigned int i, ncategories;
+
+  _blistboxes = blistboxes;
+  _clistbox.clearList();
+  ncategories = categories.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    _clistbox.addItem(categories[i]);
+    categories[i]->setBoolProp("tagged", _blistboxes[i].allTagged());
+  }
+}
+
+/*******************************************************************************
+
+Filters the displayed lists by name as the user types. When the search term
+gets longer, the previous results are narrowed down; otherwise the search
+starts over from the lists shown when the live search began. Enter keeps the
+results, like a regular search, and Esc goes back to the original lists.
+
+*******************************************************************************/
+void MainWindow::liveSearch()
+{
+  int rows, cols;
+  unsigned int i, nsearch, ncategories;
+  QuickSearch qsearch;
+  bool searching;
+  std::string selection, entry, prev_entry;
+  std::vector<BuildListBox> orig_blistboxes;
+  std::vector<ListItem *> orig_categories;
+
+  // Search from the categories list, as after filtering
+
+  _activated_listbox = 0;
+  _category_idx = 0;
+  _clistbox.setActivated(true);
+  _clistbox.setHighlight(0);
+  for ( i = 0; i < _blistboxes.size(); i++ )
+  {
+    _blistboxes[i].setActivated(false);
+  }
+  _clistbox.draw(true);
+  _blistboxes[_category_idx].draw(true);
+
+  orig_blistboxes = _blistboxes;
+  ncategories = _clistbox.numItems();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    orig_categories.push_back(_clistbox.itemByIdx(i));
+  }
+
+  getmaxyx(stdscr, rows, cols);
+
+  qsearch.setWindow(stdscr);
+  qsearch.setPosition(rows-2, 13); 
+  qsearch.setWidth(cols-13);
+  printStatus("Live search: ", true);
+
+  nsearch = 0;
+  searching = true;
+  while (searching)
+  {
+    selection = qsearch.exec(0);
+    if (selection == signals::resize)
+    {  
+      getmaxyx(stdscr, rows, cols);
+      qsearch.setPosition(rows-2, 13); 
+      qsearch.setWidth(cols-13);
+      draw(true);
+      printStatus("Live search: ", true);
+      qsearch.draw(0, true, false);
+    }
+    else if ( (selection == signals::keyEnter) || (selection == signals::quit) )
+      searching = false;
+    else if ( (selection != "ignore") &&
+              (selection != signals::highlightPrev) &&
+              (selection != signals::highlightNext) )
+    {
+      entry = qsearch.text();
+      if (entry == prev_entry) { continue; }
+      if (entry.find(prev_entry) == std::string::npos)
+        restoreLists(orig_blistboxes, orig_categories);
+      refine_search(_win2, _clistbox, _blistboxes, nsearch, entry);
+      prev_entry = entry;
+
+      setTagList();
+      _category_idx = _clistbox.highlight();
+      _clistbox.draw(true);
+      _blistboxes[_category_idx].draw(true);
+    }
+  }
+
+  // Go back to the original lists if canceled or nothing was entered
+
+  if ( (selection == signals::quit) || (prev_entry.size() == 0) )
+  {
+    if (prev_entry.size() > 0)
+    {
+      restoreLists(orig_blistboxes, orig_categories);
+      setTagList();
+      _category_idx = 0;
+      _clistbox.draw(true);
+      _blistboxes[_category_idx].draw(true);
+    }
+    clearStatus();
+    return;
+  }
+
+  _filter = "search for " + prev_entry;
+  if (settings::cumulative_filters)
+    lists_to_set(_build_index, _blistboxes, _displayed);
+
+  printSearchResult(nsearch, prev_entry, true);
+}
+
+/*******************************************************************************
+
 Filters by upgradable, tags, and then upgrades tags
 
 *******************************************************************************/
@@ -2414,6 +2916,7 @@ void MainWindow::upgradeAll(MouseEvent * mevent)
       _clistbox.tagCategory(k);
       _blistboxes[k].tagAll();
     }
+    _build_index.invalidate();
     draw(true);
 
     applyTags("Upgrade", mevent);
@@ -2584,12 +3087,34 @@ Redraws window
 *******************************************************************************/
 void MainWindow::draw(bool force)
 {
-  clear();
+  int rows, cols;
+  bool relayout;
+
+  // The whole screen is only cleared and the windows placed again when the
+  // screen size or layout has changed. Otherwise, parts are redrawn in place
+  // (over any popups that were closed), and curses only sends what differs.
+
+  getmaxyx(stdscr, rows, cols);
+  relayout = (rows != _screen_rows) || (cols != _screen_cols) ||
+             (settings::layout != _screen_layout);
+  if (relayout)
+  {
+    clear();
+    placeWindows();
+    _screen_rows = rows;
+    _screen_cols = cols;
+    _screen_layout = settings::layout;
+  }
+  else if (force)
+  {
+    touchline(stdscr, 0, 3);
+    touchline(stdscr, rows-2, 2);
+  }
 
   // Draw stuff
 
-  redrawHeaderFooter(); 
-  redrawWindows(force);
+  redrawHeaderFooter(relayout || force); 
+  redrawWindows(relayout || force);
   refreshStatus();
 }
 
@@ -2611,6 +3136,10 @@ std::string MainWindow::exec(MouseEvent * mevent)
   getting_input = true;
   while (getting_input)
   {
+    // Handle file change notifications until there is input
+
+    if (_watcher.active()) { waitForInput(); }
+
     // Get input from Categories list box
 
     if (_activated_listbox == 0)
@@ -2697,6 +3226,8 @@ std::string MainWindow::exec(MouseEvent * mevent)
     else if (selection == "e") { applyTags("Reinstall", mevent); }
     else if ( (selection.size() == 1) && (selection[0] == 0x13) )  // Ctrl-s
       quickSearch(); 
+    else if ( (selection.size() == 1) && (selection[0] == 0x06) )  // Ctrl-f
+      liveSearch(); 
     else if (selection == signals::keyF9)
     {
       activateMenubar();
@@ -0,0 +1,373 @@
+#include <string>
+#include <vector>
+#include <cstring>      // memcmp, memchr
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // fstat
+#include "MappedShellReader.h"
+
+static const char empty_string[] = "";
+
+/*******************************************************************************
+
+strview versions of the string_util functions used by ShellReader. These must
+behave exactly like their std::string counterparts.
+
+*******************************************************************************/
+static strview make_view(const char *data, std::size_t size)
+{
+  strview view;
+
+  view.data = data;
+  view.size = size;
+  return view;
+}
+
+static std::size_t view_find(const strview & view, char ch, std::size_t start)
+{
+  const void *found;
+
+  if (start >= view.size) { return std::string::npos; }
+  found = std::memchr(view.data+start, ch, view.size-start);
+  if (found == NULL) { return std::string::npos; }
+  return static_cast<const char *>(found) - view.data;
+}
+
+static strview view_trim(const strview & view)
+{
+  std::size_t len;
+  char ch;
+
+  len = view.size;
+  while (len > 0)
+  {
+    ch = view.data[len-1];
+    if ( (ch != ' ') && (ch != '\n') && (ch != '\0') ) { break; }
+    len--;
+  }
+  return make_view(view.data, len);
+}
+
+static strview view_remove_leading_whitespace(const strview & view)
+{
+  std::size_t i;
+
+  for ( i = 0; i < view.size; i++ ) { if (view.data[i] != ' ') { break; } }
+  return make_view(view.data+i, view.size-i);
+}
+
+static strview view_remove_comment(const strview & view, char delim)
+{
+  std::size_t comment_pos;
+
+  comment_pos = view_find(view, delim, 0);
+  if (comment_pos != std::string::npos)
+    return make_view(view.data, comment_pos);
+  else
+    return view;
+}
+
+/*******************************************************************************
+
+Gets the next line starting at pos (not including the newline) and advances pos
+to the start of the following line. Returns false at end of file.
+
+*******************************************************************************/
+bool MappedShellReader::nextLine(std::size_t & pos, strview & line) const
+{
+  const void *newline;
+  std::size_t end;
+
+  if (pos >= _size) { return false; }
+  newline = std::memchr(_data+pos, '\n', _size-pos);
+  if (newline == NULL) { end = _size; }
+  else { end = static_cast<const char *>(newline) - _data; }
+
+  line = make_view(_data+pos, end-pos);
+  pos = end+1;
+  return true;
+}
+
+/*******************************************************************************
+
+Checks variable name and removes 'varname=' if it is found
+
+*******************************************************************************/
+bool MappedShellReader::checkVarname(strview & line,
+                                     const std::string & varname) const
+{
+  std::size_t len;
+
+  line = view_remove_comment(line, '#');
+  line = view_remove_leading_whitespace(line);
+
+  len = varname.size();
+  if ( (line.size >= len+1) &&
+       (std::memcmp(line.data, varname.data(), len) == 0) &&
+       (line.data[len] == '=') )
+  {
+    line = make_view(line.data+len+1, line.size-len-1);
+    return true;
+  }
+  else { return false; }
+}
+
+/*******************************************************************************
+
+Reads the value of a variable given the first line, with VARNAME= already
+removed. pos is the start of the following line, used if the value spans
+multiple lines. Single-line values point into the mapping; multi-line values
+are joined with spaces into internal storage, as in ShellReader.
+
+*******************************************************************************/
+int MappedShellReader::readVariable(strview line, std::size_t pos,
+                                    strview & value)
+{
+  std::size_t len, quote_pos, end;
+  char quote;
+  strview first, next;
+  std::string joined;
+
+  // Read the first line
+
+  line = view_trim(line);
+  len = line.size;
+  if ( (len > 0) && ((line.data[0] == '"') || (line.data[0] == '\'')) )
+  {
+    quote = line.data[0];                       // Get quote character
+    quote_pos = view_find(line, quote, 1);
+    if (quote_pos != std::string::npos)
+    {
+      value = make_view(line.data+1, quote_pos-1);  // Value between quotes
+      return 0;
+    }
+    else if (line.data[len-1] == '\\')          // Line continuation
+      first = view_trim(make_view(line.data+1, len-2));
+    else                                        // Unclosed quote
+      first = view_trim(make_view(line.data+1, len-1));
+  }
+  else
+  {
+    // Just read the thing right after the equal sign
+    end = view_find(line, ' ', 0);
+    if (end == std::string::npos) { end = len; }
+    value = view_trim(make_view(line.data, end));
+    return 0;
+  }
+
+  // Keep reading subsequent lines until the quote is closed
+
+  joined = first.str();
+  while (1)
+  {
+    if (! nextLine(pos, next))
+    {
+      _joined.push_back(joined);
+      value = make_view(_joined.back().data(), _joined.back().size());
+      return 1;
+    }
+    next = view_remove_leading_whitespace(next);
+    if ( (next.size > 0) && (next.data[0] == '#') ) { continue; } // Comment
+    next = view_remove_comment(next, '#');
+    next = view_trim(next);
+
+    len = next.size;
+    quote_pos = view_find(next, quote, 1);
+    if (quote_pos != std::string::npos)         // End value
+    {
+      joined += " " + view_trim(make_view(next.data, quote_pos)).str();
+      break;
+    }
+    else if ( (len > 0) && (next.data[len-1] == '\\') ) // Line continuation
+    {
+      joined += " " + view_trim(make_view(next.data,
+                                          len >= 2 ? len-2 : 0)).str();
+    }
+    else                                        // Unclosed quote
+      joined += " " + view_trim(next).str();
+  }
+
+  _joined.push_back(joined);
+  value = make_view(_joined.back().data(), _joined.back().size());
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads the value of a default variable given the line. Default variables may not
+span multiple lines.
+
+*******************************************************************************/
+int MappedShellReader::readDefaultVariable(strview line, strview & value) const
+{
+  std::size_t dollarpos, brace0pos, colonpos, dashpos, brace1pos;
+
+  line = view_trim(line);
+
+  // Check to make sure there is a ${VAR:-DEFAULT_VAL} construct
+
+  dollarpos = view_find(line, '$', 0);
+  if (dollarpos == std::string::npos)
+    return 1;
+
+  brace0pos = view_find(line, '{', 0);
+  if (brace0pos == std::string::npos)
+    return 1;
+
+  colonpos = view_find(line, ':', 0);
+  if (colonpos == std::string::npos)
+    return 1;
+
+  dashpos = view_find(line, '-', 0);
+  if (dashpos == std::string::npos)
+    return 1;
+
+  brace1pos = view_find(line, '}', 0);
+  if (brace1pos == std::string::npos)
+    return 1;
+
+  if (brace0pos < dollarpos)
+    return 1;
+
+  if (colonpos < brace0pos)
+    return 1;
+
+  if (dashpos != colonpos+1)
+    return 1;
+
+  if (brace1pos < dashpos)
+    return 1;
+
+  // Pick out the value
+
+  value = make_view(line.data+dashpos+1, brace1pos-dashpos-1);
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Constructor and destructor
+
+*******************************************************************************/
+MappedShellReader::MappedShellReader()
+{
+  _data = NULL;
+  _size = 0;
+  _file_open = false;
+}
+
+MappedShellReader::~MappedShellReader() { close(); }
+
+/*******************************************************************************
+
+Opens or closes a file. Returns 1 on error or 0 on success.
+
+*******************************************************************************/
+int MappedShellReader::open(const std::string & filename)
+{
+  int fd;
+  struct stat sb;
+  void *map;
+
+  if (_file_open) { close(); }
+
+  fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1) { return 1; }
+  if (fstat(fd, &sb) == -1)
+  {
+    ::close(fd);
+    return 1;
+  }
+
+  // mmap cannot map an empty file, but an empty file is not an error
+
+  _size = sb.st_size;
+  if (_size == 0) { _data = empty_string; }
+  else
+  {
+    map = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED)
+    {
+      ::close(fd);
+      _size = 0;
+      return 1;
+    }
+    _data = static_cast<const char *>(map);
+  }
+  ::close(fd);
+  _file_open = true;
+
+  return 0;
+}
+
+int MappedShellReader::close()
+{
+  if (! _file_open) { return 1; }
+
+  if (_size > 0) { munmap(const_cast<char *>(_data), _size); }
+  _data = NULL;
+  _size = 0;
+  _joined.clear();
+  _file_open = false;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads variables from the file in a single pass. As in ShellReader, the first
+line setting each variable is used. Values are valid until the file is closed.
+Returns 0 if all variables were read successfully or 1 otherwise.
+
+*******************************************************************************/
+int MappedShellReader::read(std::vector<shellvar> & vars)
+{
+  std::size_t pos;
+  unsigned int k, nvars, nfound;
+  std::vector<bool> found;
+  strview line, rest;
+  int retval;
+
+  if (! _file_open) { return 1; }
+
+  nvars = vars.size();
+  found.assign(nvars, false);
+  for ( k = 0; k < nvars; k++ )
+  {
+    vars[k].value = make_view(empty_string, 0);
+    vars[k].status = 1;
+  }
+
+  // Note that scanning resumes on the line after VARNAME=, even if the value
+  // continues onto the following lines. This matches ShellReader, which
+  // searches for each variable separately from the top of the file.
+
+  pos = 0;
+  nfound = 0;
+  while ( (nfound < nvars) && nextLine(pos, line) )
+  {
+    for ( k = 0; k < nvars; k++ )
+    {
+      if (found[k]) { continue; }
+      rest = line;
+      if (checkVarname(rest, vars[k].name))
+      {
+        if (vars[k].default_var)
+          vars[k].status = readDefaultVariable(rest, vars[k].value);
+        else
+          vars[k].status = readVariable(rest, pos, vars[k].value);
+        found[k] = true;
+        nfound++;
+        break;
+      }
+    }
+  }
+
+  retval = 0;
+  for ( k = 0; k < nvars; k++ ) { if (vars[k].status != 0) { retval = 1; } }
+
+  return retval;
+}
@@ -9,6 +9,7 @@
 #include "MenubarList.h"
 #include "Menubar.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -240,7 +241,7 @@ std::string Menubar::execList(MouseEvent * mevent)
   retval = _lists[_highlight].exec(mevent);
 
   wresize(_listwins[_highlight], 0, 0);
-  wrefresh(_listwins[_highlight]);
+  frame_scheduler.schedule(_listwins[_highlight]);
 
   if (_parent)
     _parent->draw(true);
@@ -263,7 +264,7 @@ Menubar::Menubar()
   _listwins.resize(0);
   _fg_color = "fg_title";
   _bg_color = "bg_title";
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _pad = 0;
   _outerpad = 0;
   _innerpad = 0;
@@ -279,7 +280,7 @@ Menubar::Menubar(WINDOW *win)
   _listwins.resize(0);
   _fg_color = "fg_title";
   _bg_color = "bg_title";
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _pad = 0;
   _outerpad = 0;
   _innerpad = 0;
@@ -497,9 +498,9 @@ Draws menubar
 *******************************************************************************/
 void Menubar::draw(bool force)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _damage = DAMAGE_ALL; }
 
-  if (_redraw_type == "all")
+  if (_damage & DAMAGE_BACKGROUND)
   {
     int rows, cols;
 
@@ -512,7 +513,8 @@ void Menubar::draw(bool force)
   }
   else
     redrawChangedItems();
-  wrefresh(_win);
+  _damage = DAMAGE_NONE;
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -553,7 +555,7 @@ std::string Menubar::exec(MouseEvent * mevent)
     // Draw list elements
 
     draw();
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
 
     // Get user input
 
@@ -574,13 +576,13 @@ std::string Menubar::exec(MouseEvent * mevent)
 
     else if (retval == signals::keyRight)
     {
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       highlightNext();
     }
 
     else if (retval == signals::keyLeft)
     {
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       highlightPrevious();
     }
 
@@ -607,7 +609,7 @@ std::string Menubar::exec(MouseEvent * mevent)
           hotcharL = std::tolower(_lists[i].name()[hotkey]);
           if ( (retval[0] == hotcharN) || (retval[0] == hotcharL) )
           {
-            _redraw_type = "changed";
+            _damage |= DAMAGE_CHANGED;
             setHighlight(i);
           }
         }
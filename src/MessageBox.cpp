@@ -11,6 +11,7 @@
 #include "string_util.h"
 #include "MessageBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -277,6 +278,7 @@ std::string MessageBox::handleMouseEvent(MouseEvent * mevent)
           // Redraw and pause for .1 seconds to make button selection visible
 
           draw();
+          frame_scheduler.update();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -292,13 +294,15 @@ std::string MessageBox::handleMouseEvent(MouseEvent * mevent)
 
 /*******************************************************************************
 
-Draws box (frame, message). Since everything must be redrawn whenever this is
-called, there is no _redraw_type for it.
+Draws box (frame, message). Everything is redrawn unless only the buttons have
+changed.
 
 *******************************************************************************/
 void MessageBox::draw(bool force)
 {
-  if (_redraw_type == "buttons")
+  if (force) { _damage = DAMAGE_ALL; }
+
+  if (_damage == DAMAGE_BUTTONS)
     redrawButtons();
   else
   {
@@ -307,7 +311,8 @@ void MessageBox::draw(bool force)
     redrawFrame();
     redrawMessage();
   }
-  wrefresh(_win);
+  _damage = DAMAGE_NONE;
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -332,12 +337,12 @@ std::string MessageBox::exec(MouseEvent * mevent)
    
     // Draw message box
 
-    _redraw_type = "all";
+    _damage |= DAMAGE_ALL;
     draw();
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
   
       // Enter key
 
@@ -369,13 +374,13 @@ std::string MessageBox::exec(MouseEvent * mevent)
 
       case KEY_RIGHT:
         retval = signals::keyRight;
-        _redraw_type = "buttons";
+        _damage |= DAMAGE_BUTTONS;
         highlightNextButton();
         break;
 
       case KEY_LEFT:
         retval = signals::keyLeft;
-        _redraw_type = "buttons";
+        _damage |= DAMAGE_BUTTONS;
         highlightPreviousButton();
         break;
 
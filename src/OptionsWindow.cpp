@@ -497,7 +497,7 @@ std::string OptionsWindow::exec(MouseEvent * mevent)
     // Draw input box elements
   
     draw();
-    _redraw_type = "changed";
+    _damage |= DAMAGE_CHANGED;
     y_offset = _firstprint - _header_rows;
 
     // Get user input from highlighted item
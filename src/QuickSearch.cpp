@@ -5,6 +5,7 @@
 #include "TextInput.h"
 #include "QuickSearch.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -33,12 +34,12 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
     // Redraw (do not highlight, like a regular TextInput)
   
     draw(y_offset, false, false);
-    _redraw_type = "entry";
+    _damage = DAMAGE_ENTRY;
     getting_input = false;
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
 
       // Enter key: return Enter signal
 
@@ -46,7 +47,7 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
       case '\r':
       case KEY_ENTER: 
         retval = signals::keyEnter;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
 
       // Backspace key pressed: delete previous character.
@@ -79,17 +80,17 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
         getting_input = true;
         if (_cursidx > 0) { _cursidx--; }
         if (_cursidx < _firsttext) { _firsttext = _cursidx; }
-        else { _redraw_type = "none"; }
+        else { _damage = DAMAGE_NONE; }
         break;
       case KEY_RIGHT:
         getting_input = true;
         if (_cursidx < _entry.size()) { _cursidx++; }
         check_redraw = determineFirstText();
-        if (check_redraw == 0) { _redraw_type = "none"; }
+        if (check_redraw == 0) { _damage = DAMAGE_NONE; }
         break;
       case KEY_HOME:
         getting_input = true;
-        if (_cursidx == 0) { _redraw_type = "none"; }
+        if (_cursidx == 0) { _damage = DAMAGE_NONE; }
         _cursidx = 0;
         _firsttext = 0;
         break;
@@ -97,39 +98,39 @@ std::string QuickSearch::exec(int y_offset, MouseEvent * mevent)
         getting_input = true;
         _cursidx = _entry.size();
         check_redraw = determineFirstText();
-        if (check_redraw == 0) { _redraw_type = "none"; }
+        if (check_redraw == 0) { _damage = DAMAGE_NONE; }
         break;
       case KEY_PPAGE:
         retval = "ignore";
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
       case KEY_NPAGE:
         retval = "ignore";
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
       case KEY_UP:
       case MY_SHIFT_TAB:
         retval = signals::highlightPrev;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
       case KEY_DOWN:
       case MY_TAB:
         retval = signals::highlightNext;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
 
       // Resize signal
     
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
 
       // Quit key
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
 
       // Add character to entry
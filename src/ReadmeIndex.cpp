@@ -0,0 +1,464 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>    // sort, unique, lower_bound
+#include <cstdio>       // rename, remove
+#include <stdint.h>
+#include "index_io.h"
+#include "RepoIndex.h"
+#include "ReadmeIndex.h"
+
+// Bump whenever the layout of the index file changes
+
+static const char readme_magic[8] = {'S','B','O','U','I','R','D','X'};
+static const uint32_t readme_format = 2;
+
+/*******************************************************************************
+
+Whether a character is part of a word. Bytes of multibyte UTF-8 characters
+count as word characters, so that non-English words are kept whole.
+
+*******************************************************************************/
+static bool is_word_char(unsigned char c)
+{
+  return ( ( (c >= 'a') && (c <= 'z') ) || ( (c >= 'A') && (c <= 'Z') ) ||
+           ( (c >= '0') && (c <= '9') ) || (c >= 128) );
+}
+
+/*******************************************************************************
+
+Splits text into lower case words, appending them to words
+
+*******************************************************************************/
+void ReadmeIndex::tokenize(const std::string & text,
+                           std::vector<std::string> & words)
+{
+  std::size_t i, len, start;
+  std::string word;
+
+  len = text.size();
+  i = 0;
+  while (i < len)
+  {
+    while ( (i < len) && (! is_word_char(text[i])) ) { i++; }
+    start = i;
+    while ( (i < len) && (is_word_char(text[i])) ) { i++; }
+    if (i == start) { continue; }
+
+    word = text.substr(start, i-start);
+    for ( start = 0; start < word.size(); start++ )
+    {
+      if ( (word[start] >= 'A') && (word[start] <= 'Z') )
+        word[start] = word[start] - 'A' + 'a';
+    }
+    words.push_back(word);
+  }
+}
+
+/*******************************************************************************
+
+Reads the distinct words in a README file, skipping comment lines. Returns 0
+on success or 1 if the file cannot be read.
+
+*******************************************************************************/
+int ReadmeIndex::readWords(const std::string & filename,
+                           std::vector<std::string> & words)
+{
+  std::ifstream file;
+  std::string line;
+
+  words.resize(0);
+  file.open(filename.c_str());
+  if (not file.is_open()) { return 1; }
+  while (std::getline(file, line))
+  {
+    if ( (line.size() > 0) && (line[0] == '#') ) { continue; }
+    tokenize(line, words);
+  }
+  file.close();
+
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Constructor and clearing
+
+*******************************************************************************/
+ReadmeIndex::ReadmeIndex()
+{
+  _repo_dir = "";
+  _git_head = "";
+  _repo_mtime = -1;
+  _valid = false;
+}
+
+void ReadmeIndex::clear()
+{
+  _repo_dir = "";
+  _git_head = "";
+  _repo_mtime = -1;
+  _docs.clear();
+  _mtimes.clear();
+  _doc_lookup.clear();
+  _words.clear();
+  _postings.clear();
+  _pending.clear();
+  _valid = false;
+}
+
+/*******************************************************************************
+
+Builds hash table for lookup by category/name
+
+*******************************************************************************/
+void ReadmeIndex::buildLookup()
+{
+  unsigned int i, ndocs;
+
+  _doc_lookup.clear();
+  ndocs = _docs.size();
+  _doc_lookup.reserve(ndocs);
+  for ( i = 0; i < ndocs; i++ ) { _doc_lookup[_docs[i]] = i; }
+}
+
+/*******************************************************************************
+
+Modification time of a README in the repository the index was written for
+
+*******************************************************************************/
+long long ReadmeIndex::readmeMtime(unsigned int doc) const
+{
+  return RepoIndex::dirMtime(_repo_dir + "/" + _docs[doc] + "/README");
+}
+
+/*******************************************************************************
+
+Adds the words of a README to the index. Posting lists are built by stamp().
+
+*******************************************************************************/
+void ReadmeIndex::addReadme(const std::string & category,
+                            const std::string & name,
+                            const std::vector<std::string> & words)
+{
+  _docs.push_back(category + "/" + name);
+  _pending.push_back(words);
+}
+
+/*******************************************************************************
+
+Builds posting lists from the READMEs added, records git HEAD and modification
+times of the repository and each README, and marks the index valid
+
+*******************************************************************************/
+void ReadmeIndex::stamp(const std::string & repo_dir)
+{
+  std::map<std::string, std::vector<unsigned int> > inverted;
+  std::map<std::string, std::vector<unsigned int> >::iterator it;
+  unsigned int i, k, ndocs;
+
+  ndocs = _pending.size();
+  for ( i = 0; i < ndocs; i++ )
+  {
+    for ( k = 0; k < _pending[i].size(); k++ )
+    {
+      inverted[_pending[i][k]].push_back(i);
+    }
+  }
+  _pending.clear();
+
+  _words.resize(0);
+  _postings.resize(0);
+  _words.reserve(inverted.size());
+  _postings.reserve(inverted.size());
+  for ( it = inverted.begin(); it != inverted.end(); it++ )
+  {
+    _words.push_back(it->first);
+    _postings.push_back(it->second);
+  }
+
+  _repo_dir = repo_dir;
+  _git_head = RepoIndex::gitHead(repo_dir);
+  _repo_mtime = RepoIndex::dirMtime(repo_dir);
+  _mtimes.resize(ndocs);
+  for ( i = 0; i < ndocs; i++ ) { _mtimes[i] = readmeMtime(i); }
+  buildLookup();
+  _valid = true;
+}
+
+/*******************************************************************************
+
+Reads index from file. Returns 0 on success, 1 if the file cannot be read, 2 if
+it is not a valid index file, or 3 if it is out of date with respect to
+repo_dir (only checked if require_current is true).
+
+*******************************************************************************/
+int ReadmeIndex::read(const std::string & filename,
+                      const std::string & repo_dir, bool require_current)
+{
+  std::ifstream file;
+  std::stringstream ss;
+  std::string buf;
+  std::size_t pos;
+  uint32_t format, ndocs, nwords, nposts, doc, i, j;
+  int64_t mtime;
+  int check;
+
+  clear();
+
+  file.open(filename.c_str(), std::ios::in | std::ios::binary);
+  if (not file.is_open()) { return 1; }
+  ss << file.rdbuf();
+  file.close();
+  buf = ss.str();
+
+  // Header
+
+  if ( (buf.size() < sizeof(readme_magic)) ||
+       (buf.compare(0, sizeof(readme_magic), readme_magic,
+                    sizeof(readme_magic)) != 0) ) { return 2; }
+  pos = sizeof(readme_magic);
+  check = read_uint(buf, pos, format);
+  if ( (check != 0) || (format != readme_format) ) { return 2; }
+  check += read_string(buf, pos, _repo_dir);
+  check += read_string(buf, pos, _git_head);
+  check += read_int64(buf, pos, mtime);
+  _repo_mtime = mtime;
+
+  // Documents, then words with their posting lists
+
+  check += read_uint(buf, pos, ndocs);
+  if (check == 0)
+  {
+    _docs.resize(ndocs);
+    _mtimes.resize(ndocs);
+  }
+  for ( i = 0; (check == 0) && (i < ndocs); i++ )
+  {
+    check += read_string(buf, pos, _docs[i]);
+    check += read_int64(buf, pos, mtime);
+    _mtimes[i] = mtime;
+  }
+  if (check == 0) { check += read_uint(buf, pos, nwords); }
+  if (check == 0)
+  {
+    _words.resize(nwords);
+    _postings.resize(nwords);
+  }
+  for ( i = 0; (check == 0) && (i < nwords); i++ )
+  {
+    check += read_string(buf, pos, _words[i]);
+    check += read_uint(buf, pos, nposts);
+    if (check != 0) { break; }
+    _postings[i].resize(nposts);
+    for ( j = 0; j < nposts; j++ )
+    {
+      check += read_uint(buf, pos, doc);
+      if ( (check != 0) || (doc >= ndocs) )
+      {
+        check += 1;
+        break;
+      }
+      _postings[i][j] = doc;
+    }
+  }
+  if (check != 0)
+  {
+    clear();
+    return 2;
+  }
+
+  // Make sure it is still current
+
+  if ( require_current &&
+       ( (repo_dir != _repo_dir) ||
+         (RepoIndex::gitHead(repo_dir) != _git_head) ||
+         (RepoIndex::dirMtime(repo_dir) != _repo_mtime) ) )
+  {
+    clear();
+    return 3;
+  }
+
+  buildLookup();
+  _valid = true;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Writes index to file, via a temporary file as with RepoIndex. Returns 0 on
+success or 1 on error.
+
+*******************************************************************************/
+int ReadmeIndex::write(const std::string & filename) const
+{
+  std::ofstream file;
+  std::string tmpfile;
+  unsigned int i, j, ndocs, nwords;
+
+  tmpfile = filename + ".tmp";
+  file.open(tmpfile.c_str(), std::ios::out | std::ios::binary |
+                             std::ios::trunc);
+  if (not file.is_open()) { return 1; }
+
+  file.write(readme_magic, sizeof(readme_magic));
+  write_uint(file, readme_format);
+  write_string(file, _repo_dir);
+  write_string(file, _git_head);
+  write_int64(file, _repo_mtime);
+
+  ndocs = _docs.size();
+  write_uint(file, ndocs);
+  for ( i = 0; i < ndocs; i++ )
+  {
+    write_string(file, _docs[i]);
+    write_int64(file, _mtimes[i]);
+  }
+
+  nwords = _words.size();
+  write_uint(file, nwords);
+  for ( i = 0; i < nwords; i++ )
+  {
+    write_string(file, _words[i]);
+    write_uint(file, _postings[i].size());
+    for ( j = 0; j < _postings[i].size(); j++ )
+    {
+      write_uint(file, _postings[i][j]);
+    }
+  }
+
+  file.close();
+  if (file.fail())
+  {
+    std::remove(tmpfile.c_str());
+    return 1;
+  }
+  if (std::rename(tmpfile.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(tmpfile.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Access
+
+*******************************************************************************/
+bool ReadmeIndex::valid() const { return _valid; }
+const std::vector<std::string> & ReadmeIndex::documents() const
+{
+  return _docs;
+}
+
+/*******************************************************************************
+
+Gets the words of each README from the posting lists, e.g. to reuse them for
+READMEs that have not changed when the index is regenerated
+
+*******************************************************************************/
+void ReadmeIndex::documentWords(
+                        std::vector<std::vector<std::string> > & words) const
+{
+  unsigned int i, j, nwords;
+
+  words.assign(_docs.size(), std::vector<std::string>());
+  nwords = _words.size();
+  for ( i = 0; i < nwords; i++ )
+  {
+    for ( j = 0; j < _postings[i].size(); j++ )
+    {
+      words[_postings[i][j]].push_back(_words[i]);
+    }
+  }
+}
+
+/*******************************************************************************
+
+Queries
+
+*******************************************************************************/
+int ReadmeIndex::docId(const std::string & category,
+                       const std::string & name) const
+{
+  std::unordered_map<std::string, unsigned int>::const_iterator it;
+
+  if (! _valid) { return -1; }
+  it = _doc_lookup.find(category + "/" + name);
+  if (it == _doc_lookup.end()) { return -1; }
+  return it->second;
+}
+
+bool ReadmeIndex::docUpToDate(unsigned int doc) const
+{
+  return (readmeMtime(doc) == _mtimes[doc]);
+}
+
+/*******************************************************************************
+
+Marks READMEs that may contain pattern. Every word of pattern must be a word of
+the README for a whole-word search, or part of one otherwise. READMEs that have
+changed since the index was written are always marked. Returns 0, or 1 if
+pattern has no words.
+
+*******************************************************************************/
+int ReadmeIndex::candidates(const std::string & pattern, bool whole_word,
+                            std::vector<char> & is_candidate) const
+{
+  std::vector<std::string> query;
+  std::vector<std::string>::const_iterator it;
+  std::vector<char> found;
+  unsigned int i, j, k, ndocs, nwords;
+
+  tokenize(pattern, query);
+  if (query.size() == 0) { return 1; }
+
+  ndocs = _docs.size();
+  nwords = _words.size();
+  is_candidate.assign(ndocs, 1);
+  for ( k = 0; k < query.size(); k++ )
+  {
+    found.assign(ndocs, 0);
+    if (whole_word)
+    {
+      it = std::lower_bound(_words.begin(), _words.end(), query[k]);
+      if ( (it != _words.end()) && (*it == query[k]) )
+      {
+        i = it - _words.begin();
+        for ( j = 0; j < _postings[i].size(); j++ )
+        {
+          found[_postings[i][j]] = 1;
+        }
+      }
+    }
+    else
+    {
+      for ( i = 0; i < nwords; i++ )
+      {
+        if (_words[i].find(query[k]) == std::string::npos) { continue; }
+        for ( j = 0; j < _postings[i].size(); j++ )
+        {
+          found[_postings[i][j]] = 1;
+        }
+      }
+    }
+    for ( i = 0; i < ndocs; i++ ) { is_candidate[i] &= found[i]; }
+  }
+
+  // The index cannot rule out READMEs that were edited in place
+
+  for ( i = 0; i < ndocs; i++ )
+  {
+    if ( (! is_candidate[i]) && (! docUpToDate(i)) ) { is_candidate[i] = 1; }
+  }
+
+  return 0;
+}
@@ -0,0 +1,454 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>       // rename, remove
+#include <stdint.h>
+#include <sys/stat.h>
+#include "string_util.h"
+#include "index_io.h"
+#include "RepoIndex.h"
+
+// Bump whenever the layout of the index file changes
+
+static const char index_magic[8] = {'S','B','O','U','I','I','D','X'};
+static const uint32_t index_format = 3;
+
+/*******************************************************************************
+
+Builds hash table for lookup by category/name
+
+*******************************************************************************/
+void RepoIndex::buildLookup()
+{
+  unsigned int i, nbuilds;
+
+  _lookup.clear();
+  nbuilds = _builds.size();
+  _lookup.reserve(nbuilds);
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    _lookup[_builds[i].category + "/" + _builds[i].name] = i;
+  }
+}
+
+/*******************************************************************************
+
+Returns the commit that HEAD points to in a git repository, or an empty string
+if repo_dir is not a git repository
+
+*******************************************************************************/
+std::string RepoIndex::gitHead(const std::string & repo_dir)
+{
+  std::ifstream file;
+  std::string line, ref, gitdir;
+  std::vector<std::string> splitline;
+
+  gitdir = repo_dir + "/.git/";
+  file.open((gitdir + "HEAD").c_str());
+  if (not file.is_open()) { return ""; }
+  std::getline(file, line);
+  file.close();
+  line = trim(line);
+
+  // Detached HEAD contains the commit itself
+
+  if (line.substr(0, 5) != "ref: ") { return line; }
+  ref = trim(line.substr(5));
+
+  // Loose ref
+
+  file.open((gitdir + ref).c_str());
+  if (file.is_open())
+  {
+    std::getline(file, line);
+    file.close();
+    return trim(line);
+  }
+
+  // Packed ref
+
+  file.open((gitdir + "packed-refs").c_str());
+  if (not file.is_open()) { return ""; }
+  while (! file.eof())
+  {
+    std::getline(file, line);
+    splitline = split(trim(line));
+    if ( (splitline.size() == 2) && (splitline[1] == ref) )
+    {
+      file.close();
+      return splitline[0];
+    }
+  }
+  file.close();
+
+  return "";
+}
+
+/*******************************************************************************
+
+Returns modification time of a directory (or file), or -1 if it cannot be
+accessed
+
+*******************************************************************************/
+long long RepoIndex::dirMtime(const std::string & path)
+{
+  struct stat sb;
+
+  if (stat(path.c_str(), &sb) == -1) { return -1; }
+  return (long long)(sb.st_mtime);
+}
+
+/*******************************************************************************
+
+Returns the newest modification time of a SlackBuild's directory and the files
+that the index is read from (.info, .SlackBuild, and slack-desc)
+
+*******************************************************************************/
+long long RepoIndex::buildMtime(const std::string & repo_dir,
+                                const std::string & category,
+                                const std::string & name)
+{
+  std::string path;
+  long long mtime, newest;
+
+  path = repo_dir + "/" + category + "/" + name;
+  newest = dirMtime(path);
+  mtime = dirMtime(path + "/" + name + ".info");
+  if (mtime > newest) { newest = mtime; }
+  mtime = dirMtime(path + "/" + name + ".SlackBuild");
+  if (mtime > newest) { newest = mtime; }
+  mtime = dirMtime(path + "/slack-desc");
+  if (mtime > newest) { newest = mtime; }
+
+  return newest;
+}
+
+/*******************************************************************************
+
+Constructor
+
+*******************************************************************************/
+RepoIndex::RepoIndex()
+{
+  _repo_dir = "";
+  _git_head = "";
+  _repo_mtime = -1;
+  _categories.resize(0);
+  _builds.resize(0);
+  _valid = false;
+}
+
+/*******************************************************************************
+
+Clears index contents and marks it invalid
+
+*******************************************************************************/
+void RepoIndex::clear()
+{
+  _repo_dir = "";
+  _git_head = "";
+  _repo_mtime = -1;
+  _categories.clear();
+  _builds.clear();
+  _lookup.clear();
+  _valid = false;
+}
+
+/*******************************************************************************
+
+Adds a SlackBuild to the index. Builds must be added grouped by category, in the
+same order as they are listed in the repository.
+
+*******************************************************************************/
+void RepoIndex::addBuild(const std::string & category, const std::string & name,
+                         const std::string & version, const std::string & reqs,
+                         const std::string & buildnum,
+                         const std::string & shortdesc, int status)
+{
+  indexentry entry;
+  unsigned int ncategories;
+
+  ncategories = _categories.size();
+  if ( (ncategories == 0) || (_categories[ncategories-1].name != category) )
+  {
+    indexcategory cat;
+    cat.name = category;
+    cat.mtime = -1;
+    cat.first = _builds.size();
+    cat.nbuilds = 0;
+    _categories.push_back(cat);
+    ncategories++;
+  }
+
+  entry.category = category;
+  entry.name = name;
+  entry.version = version;
+  entry.reqs = reqs;
+  entry.buildnum = buildnum;
+  entry.shortdesc = shortdesc;
+  entry.status = status;
+  entry.mtime = -1;
+  _builds.push_back(entry);
+  _categories[ncategories-1].nbuilds++;
+}
+
+/*******************************************************************************
+
+Records git HEAD and modification times for the repository, its categories,
+and each SlackBuild, and marks the index valid
+
+*******************************************************************************/
+void RepoIndex::stamp(const std::string & repo_dir)
+{
+  unsigned int i, ncategories, nbuilds;
+
+  _repo_dir = repo_dir;
+  _git_head = gitHead(repo_dir);
+  _repo_mtime = dirMtime(repo_dir);
+  ncategories = _categories.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    _categories[i].mtime = dirMtime(repo_dir + "/" + _categories[i].name);
+  }
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    _builds[i].mtime = buildMtime(repo_dir, _builds[i].category,
+                                  _builds[i].name);
+  }
+  buildLookup();
+  _valid = true;
+}
+
+/*******************************************************************************
+
+Reads index from file. Returns 0 on success, 1 if the file cannot be read, 2 if
+it is not a valid index file, or 3 if it is out of date with respect to
+repo_dir (only checked if require_current is true).
+
+*******************************************************************************/
+int RepoIndex::read(const std::string & filename, const std::string & repo_dir,
+                    bool require_current)
+{
+  std::ifstream file;
+  std::stringstream ss;
+  std::string buf, category, name, version, reqs, buildnum, shortdesc;
+  std::size_t pos;
+  uint32_t format, ncategories, nbuilds, i, j;
+  int64_t mtime;
+  int check;
+
+  clear();
+
+  file.open(filename.c_str(), std::ios::in | std::ios::binary);
+  if (not file.is_open()) { return 1; }
+  ss << file.rdbuf();
+  file.close();
+  buf = ss.str();
+
+  // Header
+
+  if ( (buf.size() < sizeof(index_magic)) ||
+       (buf.compare(0, sizeof(index_magic), index_magic,
+                    sizeof(index_magic)) != 0) ) { return 2; }
+  pos = sizeof(index_magic);
+  check = read_uint(buf, pos, format);
+  if ( (check != 0) || (format != index_format) ) { return 2; }
+  check += read_string(buf, pos, _repo_dir);
+  check += read_string(buf, pos, _git_head);
+  check += read_int64(buf, pos, mtime);
+  _repo_mtime = mtime;
+  check += read_uint(buf, pos, ncategories);
+  if (check != 0)
+  {
+    clear();
+    return 2;
+  }
+
+  // Categories and SlackBuilds
+
+  for ( i = 0; i < ncategories; i++ )
+  {
+    check += read_string(buf, pos, category);
+    check += read_int64(buf, pos, mtime);
+    check += read_uint(buf, pos, nbuilds);
+    if (check != 0) { break; }
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      uint32_t status;
+      int64_t build_mtime;
+
+      check += read_string(buf, pos, name);
+      check += read_string(buf, pos, version);
+      check += read_string(buf, pos, reqs);
+      check += read_string(buf, pos, buildnum);
+      check += read_string(buf, pos, shortdesc);
+      check += read_uint(buf, pos, status);
+      check += read_int64(buf, pos, build_mtime);
+      if (check != 0) { break; }
+      addBuild(category, name, version, reqs, buildnum, shortdesc,
+               int(status));
+      _builds[_builds.size()-1].mtime = build_mtime;
+    }
+    if (check != 0) { break; }
+    if (nbuilds > 0) { _categories[_categories.size()-1].mtime = mtime; }
+  }
+  if (check != 0)
+  {
+    clear();
+    return 2;
+  }
+
+  // Make sure it is still current
+
+  if ( require_current && (! upToDate(repo_dir)) )
+  {
+    clear();
+    return 3;
+  }
+
+  buildLookup();
+  _valid = true;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Writes index to file. The file is written to a temporary location first and
+then moved into place, so readers never see a partial index. Returns 0 on
+success or 1 on error.
+
+*******************************************************************************/
+int RepoIndex::write(const std::string & filename) const
+{
+  std::ofstream file;
+  std::string tmpfile;
+  unsigned int i, j, ncategories;
+  const indexcategory *cat;
+  const indexentry *entry;
+
+  tmpfile = filename + ".tmp";
+  file.open(tmpfile.c_str(), std::ios::out | std::ios::binary |
+                             std::ios::trunc);
+  if (not file.is_open()) { return 1; }
+
+  file.write(index_magic, sizeof(index_magic));
+  write_uint(file, index_format);
+  write_string(file, _repo_dir);
+  write_string(file, _git_head);
+  write_int64(file, _repo_mtime);
+
+  ncategories = _categories.size();
+  write_uint(file, ncategories);
+  for ( i = 0; i < ncategories; i++ )
+  {
+    cat = &_categories[i];
+    write_string(file, cat->name);
+    write_int64(file, cat->mtime);
+    write_uint(file, cat->nbuilds);
+    for ( j = cat->first; j < cat->first + cat->nbuilds; j++ )
+    {
+      entry = &_builds[j];
+      write_string(file, entry->name);
+      write_string(file, entry->version);
+      write_string(file, entry->reqs);
+      write_string(file, entry->buildnum);
+      write_string(file, entry->shortdesc);
+      write_uint(file, uint32_t(entry->status));
+      write_int64(file, entry->mtime);
+    }
+  }
+
+  file.close();
+  if (file.fail())
+  {
+    std::remove(tmpfile.c_str());
+    return 1;
+  }
+  if (std::rename(tmpfile.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(tmpfile.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Checks whether index is up to date with the repository: same location, same git
+HEAD, no categories or SlackBuilds added or removed, and no SlackBuilds
+modified since it was written
+
+*******************************************************************************/
+bool RepoIndex::upToDate(const std::string & repo_dir) const
+{
+  unsigned int i, ncategories, nbuilds;
+
+  if (repo_dir != _repo_dir) { return false; }
+  if (gitHead(repo_dir) != _git_head) { return false; }
+  if (dirMtime(repo_dir) != _repo_mtime) { return false; }
+
+  ncategories = _categories.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    if (dirMtime(repo_dir + "/" + _categories[i].name) !=
+        _categories[i].mtime) { return false; }
+  }
+
+  nbuilds = _builds.size();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (! buildUpToDate(_builds[i])) { return false; }
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+
+Checks whether an entry is up to date with its SlackBuild in the repository the
+index was written for
+
+*******************************************************************************/
+bool RepoIndex::buildUpToDate(const indexentry & entry) const
+{
+  return (buildMtime(_repo_dir, entry.category, entry.name) == entry.mtime);
+}
+
+bool RepoIndex::valid() const { return _valid; }
+
+void RepoIndex::forget(const std::string & category, const std::string & name)
+{
+  _lookup.erase(category + "/" + name);
+}
+
+/*******************************************************************************
+
+Access. Warning: category() and build() do not check bounds.
+
+*******************************************************************************/
+unsigned int RepoIndex::numCategories() const { return _categories.size(); }
+
+const indexcategory & RepoIndex::category(unsigned int idx) const
+{
+  return _categories[idx];
+}
+
+const indexentry & RepoIndex::build(unsigned int idx) const
+{
+  return _builds[idx];
+}
+
+const indexentry * RepoIndex::find(const std::string & category,
+                                   const std::string & name) const
+{
+  std::unordered_map<std::string, unsigned int>::const_iterator it;
+
+  if (! _valid) { return NULL; }
+  it = _lookup.find(category + "/" + name);
+  if (it == _lookup.end()) { return NULL; }
+  return &_builds[it->second];
+}
@@ -11,6 +11,7 @@
 #include "AbstractListBox.h"
 #include "ScrollBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -285,8 +286,9 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
 
           // Redraw and pause for .1 seconds to make button selection visible
 
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           draw();
+          frame_scheduler.update();
           std::this_thread::sleep_for(std::chrono::milliseconds(100));
           return _button_signals[i];
         }
@@ -310,9 +312,7 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = scrollPreviousPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
-          else
-            _redraw_type = "none";
+            _damage |= DAMAGE_SCROLLED;
           return signals::scroll;
         }
         else
@@ -324,9 +324,7 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
         {
           check_redraw = scrollNextPage();
           if (check_redraw == 1)
-            _redraw_type = "all";
-          else
-            _redraw_type = "none";
+            _damage |= DAMAGE_SCROLLED;
           return signals::scroll;
         }
         else
@@ -338,9 +336,7 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
                double(rowsavail-1);
         check_redraw = scrollFractional(frac);
         if (check_redraw == 1)
-          _redraw_type = "all";
-        else
-          _redraw_type = "none";
+          _damage |= DAMAGE_SCROLLED;
         return signals::scroll;
       }
     }
@@ -355,18 +351,14 @@ std::string ScrollBox::handleMouseEvent(MouseEvent * mevent)
   {
     check_redraw = scrollPreviousPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
-    else
-      _redraw_type = "none";
+      _damage |= DAMAGE_SCROLLED;
     return signals::scroll;
   }
   else if (mevent->button() == 5)
   {
     check_redraw = scrollNextPage();
     if (check_redraw == 1)
-      _redraw_type = "all";
-    else
-      _redraw_type = "none";
+      _damage |= DAMAGE_SCROLLED;
     return signals::scroll;
   }
   else
@@ -394,7 +386,7 @@ std::string ScrollBox::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: accept selection
 
@@ -402,14 +394,14 @@ std::string ScrollBox::exec(MouseEvent * mevent)
     case '\r':
     case KEY_ENTER:
       retval = signals::keyEnter;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Tab key: return keyTab
 
     case MY_TAB:
       retval = signals::keyTab;
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Arrows/Home/End/PgUp/Dn: scrolling
@@ -417,52 +409,46 @@ std::string ScrollBox::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::scroll;
       check_redraw = scrollUp();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
       break;
     case KEY_DOWN:
       retval = signals::scroll;
       check_redraw = scrollDown();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
       break;
     case KEY_PPAGE:
       retval = signals::scroll;
       check_redraw = scrollPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
       break;
     case KEY_NPAGE:
       retval = signals::scroll;
       check_redraw = scrollNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
       break;
     case KEY_HOME:
       retval = signals::scroll;
       check_redraw = scrollFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
       break;
     case KEY_END:
       retval = signals::scroll;
       check_redraw = scrollLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "none"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
       break;
 
     // Resize signal
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Mouse
@@ -471,7 +457,6 @@ std::string ScrollBox::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "none";
         retval = signals::mouseEvent;
       }
       else
@@ -480,7 +465,7 @@ std::string ScrollBox::exec(MouseEvent * mevent)
 
     default:
       retval = char(ch);
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
   }
   return retval;
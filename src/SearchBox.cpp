@@ -127,11 +127,17 @@ SearchBox::SearchBox()
   _readmeitem.setWidth(30);
   _readmeitem.setPosition(8,1);
 
+  addItem(&_fuzzyitem);
+  _fuzzyitem.setName("Fuzzy match + descriptions");
+  _fuzzyitem.setEnabled(false);
+  _fuzzyitem.setWidth(30);
+  _fuzzyitem.setPosition(9,1);
+
   addItem(&_currentlistitem);
   _currentlistitem.setName("Current list only");
   _currentlistitem.setEnabled(false);
   _currentlistitem.setWidth(30);
-  _currentlistitem.setPosition(9,1);
+  _currentlistitem.setPosition(10,1);
 }
 
 SearchBox::~SearchBox() { delete _items[0]; }
@@ -152,4 +158,5 @@ std::string SearchBox::searchString() const { return _entryitem.text(); }
 bool SearchBox::caseSensitive() const { return _caseitem.enabled(); }
 bool SearchBox::wholeWord() const { return _wholeitem.enabled(); }
 bool SearchBox::searchREADMEs() const { return _readmeitem.enabled(); }
+bool SearchBox::fuzzyMatch() const { return _fuzzyitem.enabled(); }
 bool SearchBox::currentList() const { return _currentlistitem.enabled(); }
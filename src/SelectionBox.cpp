@@ -7,6 +7,7 @@
 #include "ListItem.h"
 #include "SelectionBox.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -85,7 +86,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
 
       // Enter key: accept selection
 
@@ -96,7 +97,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
           retval = _button_signals[_highlighted_button];
         else
           retval = signals::keyEnter;
-        _redraw_type = "all";
+        _damage |= DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -104,33 +105,33 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case KEY_UP:
         check_redraw = highlightPrevious();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_DOWN:
         check_redraw = highlightNext();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_PPAGE:
         check_redraw = highlightPreviousPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_NPAGE:
         check_redraw = highlightNextPage();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_HOME:
         check_redraw = highlightFirst();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
       case KEY_END:
         check_redraw = highlightLast();
-        if (check_redraw == 1) { _redraw_type = "all"; }
-        else { _redraw_type = "changed"; }
+        if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+        else { _damage |= DAMAGE_CHANGED; }
         break;
 
       // Right/Left: change highlighted button
@@ -139,13 +140,12 @@ std::string SelectionBox::exec(MouseEvent * mevent)
         if (_buttons.size() > 0)
         {
           check_redraw = highlightNextButton();
-          if (check_redraw == 1) { _redraw_type = "buttons"; }
-          else { _redraw_type = "none"; }
+          if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
         }
         else
         {
           retval = signals::keyRight;
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           getting_input = false;
         }
         break;
@@ -154,13 +154,12 @@ std::string SelectionBox::exec(MouseEvent * mevent)
         if (_buttons.size() > 0)
         {
           check_redraw = highlightPreviousButton();
-          if (check_redraw == 1) { _redraw_type = "buttons"; }
-          else { _redraw_type = "none"; }
+          if (check_redraw == 1) { _damage |= DAMAGE_BUTTONS; }
         }
         else
         {
           retval = signals::keyLeft;
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
           getting_input = false;
         }
         break;
@@ -169,7 +168,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "all";
+        _damage |= DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -177,7 +176,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "all";
+        _damage |= DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -185,7 +184,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
 
       case KEY_F(9):
         retval = signals::keyF9;
-        _redraw_type = "all";
+        _damage |= DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -199,19 +198,18 @@ std::string SelectionBox::exec(MouseEvent * mevent)
           if ( (retval == signals::keyEnter) || (retval == signals::quit) )
           {
             getting_input = false;
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
           }
           else if ( (retval == signals::nullEvent) && (! _modal) )
           {
             retval = signals::mouseEvent;
             getting_input = false;
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
           }
         }
         break;
 
       default:
-        _redraw_type = "none";
         check_hotkeys = true;
         getting_input = true;
         break;
@@ -234,7 +232,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
             if ( (ch_char == hotcharN) || (ch_char == hotcharL) )
             {
               retval = hotcharN;
-              _redraw_type = "all";
+              _damage |= DAMAGE_ALL;
               getting_input = true;
               setHighlight(i);
               break;
@@ -248,7 +246,7 @@ std::string SelectionBox::exec(MouseEvent * mevent)
           if ( (ch_char == hotcharN) || (ch_char == hotcharL) )
           {
             retval = hotcharN;
-            _redraw_type = "all";
+            _damage |= DAMAGE_ALL;
             getting_input = false;
             break;
           }
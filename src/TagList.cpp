@@ -10,6 +10,7 @@
 #include "SelectionBox.h"
 #include "TagList.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
  
@@ -113,7 +114,8 @@ void TagList::removeItem(ListItem *item)
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 void TagList::removeItem(unsigned int idx)
@@ -122,7 +124,8 @@ void TagList::removeItem(unsigned int idx)
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 void TagList::clearList()
@@ -132,7 +135,8 @@ void TagList::clearList()
   _highlight = 0;
   _firstprint = 0;
   _prevhighlight = 0;
-  _redraw_type = "all";
+  invalidateMetrics();
+  _damage |= DAMAGE_ALL;
 }
 
 /*******************************************************************************
@@ -186,6 +190,7 @@ unsigned int TagList::getDisplayList(const std::string & action)
       _items.push_back(_tagged[i]);
     }
   }
+  invalidateMetrics();
 
   return numItems();
 } 
@@ -214,7 +219,7 @@ std::string TagList::handleMouseEvent(MouseEvent * mevent)
   {
     _items[_highlight]->setBoolProp("marked", 
                                (! _items[_highlight]->getBoolProp("marked")));
-    _redraw_type = "changed";
+    _damage |= DAMAGE_CHANGED;
   }
 
   return retval;
@@ -246,7 +251,7 @@ std::string TagList::exec(MouseEvent * mevent)
 
   // Get user input
 
-  switch (ch = getch()) {
+  switch (ch = frame_scheduler.getInput()) {
 
     // Enter key: accept selection
 
@@ -258,7 +263,7 @@ std::string TagList::exec(MouseEvent * mevent)
         retval = _button_signals[_highlighted_button];
       else
         retval = signals::keyEnter;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Arrows/Home/End/PgUp/Dn: change highlighted value
@@ -266,38 +271,38 @@ std::string TagList::exec(MouseEvent * mevent)
     case KEY_UP:
       retval = signals::highlight;
       check_redraw = highlightPrevious();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_DOWN:
       retval = signals::highlight;
       check_redraw = highlightNext();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_PPAGE:
       retval = signals::highlight;
       check_redraw = highlightPreviousPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_NPAGE:
       retval = signals::highlight;
       check_redraw = highlightNextPage();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_HOME:
       retval = signals::highlight;
       check_redraw = highlightFirst();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
     case KEY_END:
       retval = signals::highlight;
       check_redraw = highlightLast();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     // Right/left: change highlighted button
@@ -305,29 +310,29 @@ std::string TagList::exec(MouseEvent * mevent)
     case KEY_RIGHT:
       retval = signals::keyRight;
       check_redraw = highlightNextButton();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     case KEY_LEFT:
       retval = signals::keyLeft;
       check_redraw = highlightPreviousButton();
-      if (check_redraw == 1) { _redraw_type = "all"; }
-      else { _redraw_type = "changed"; }
+      if (check_redraw == 1) { _damage |= DAMAGE_SCROLLED; }
+      else { _damage |= DAMAGE_CHANGED; }
       break;
 
     // Resize signal: redraw (may not work with some curses implementations)
 
     case KEY_RESIZE:
       retval = signals::resize;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Quit key
 
     case MY_ESC:
       retval = signals::quit;
-      _redraw_type = "all";
+      _damage |= DAMAGE_ALL;
       break;
 
     // Space: toggle item
@@ -336,7 +341,7 @@ std::string TagList::exec(MouseEvent * mevent)
       retval = " ";
       _items[_highlight]->setBoolProp("marked", 
                                  (! _items[_highlight]->getBoolProp("marked")));
-      _redraw_type = "changed";
+      _damage |= DAMAGE_CHANGED;
       break;
 
     // Mouse
@@ -345,16 +350,15 @@ std::string TagList::exec(MouseEvent * mevent)
       if ( (getmouse(&event) == OK) && mevent )
       {
         mevent->recordClick(event);
-        _redraw_type = "changed";
+        _damage |= DAMAGE_CHANGED;
         retval = handleMouseEvent(mevent);
         if ( (retval == signals::keyEnter) || (retval == signals::quit) )
-          _redraw_type = "all";
+          _damage |= DAMAGE_ALL;
       }
       break;
 
     default:
       retval = char(ch);
-      _redraw_type = "none";
       break;
   }
   curs_set(0);
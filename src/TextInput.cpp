@@ -6,6 +6,7 @@
 #include "InputItem.h"
 #include "TextInput.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -61,7 +62,7 @@ Constructor
 *******************************************************************************/
 TextInput::TextInput()
 {
-  _redraw_type = "entry";
+  _damage = DAMAGE_ENTRY;
   _item_type = "TextInput";
   _selectable = true;
   _entry = "";
@@ -131,7 +132,7 @@ std::string TextInput::handleMouseEvent(MouseEvent * mevent, int y_offset)
         _cursidx = _entry.size();
       else
         _cursidx = xcurs-_posx+_firsttext-_labellen;
-      _redraw_type = "entry";
+      _damage = DAMAGE_ENTRY;
       return signals::nullEvent;  // Because the event was handled here
     }
   }
@@ -146,7 +147,7 @@ Draws text input
 *******************************************************************************/
 void TextInput::draw(int y_offset, bool force, bool highlight)
 {
-  if (force) { _redraw_type = "entry"; }
+  if (force) { _damage = DAMAGE_ENTRY; }
 
   if (highlight)
   {
@@ -154,12 +155,12 @@ void TextInput::draw(int y_offset, bool force, bool highlight)
       wattron(_win, A_REVERSE);
   }
 
-  if (_redraw_type == "entry") { redrawEntry(y_offset); }
+  if (_damage & DAMAGE_ENTRY) { redrawEntry(y_offset); }
   wmove(_win, _posy-y_offset, _posx + _cursidx + _labellen - _firsttext);
 
   if (highlight)
     if (colors.turnOff(_win) != 0) { wattroff(_win, A_REVERSE); }
-  wrefresh(_win);
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -188,11 +189,11 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
     // Redraw
   
     draw(y_offset, false, true);
-    _redraw_type = "entry";
+    _damage = DAMAGE_ENTRY;
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
 
       // Enter key: return Enter signal
 
@@ -200,7 +201,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
       case '\r':
       case KEY_ENTER: 
         retval = signals::keyEnter;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
 
@@ -237,7 +238,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
         else
         {
           retval = signals::keyLeft;
-          _redraw_type = "entry";
+          _damage = DAMAGE_ENTRY;
           getting_input = false;
         }
         break;
@@ -246,45 +247,45 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
         {
           _cursidx++;
           check_redraw = determineFirstText();
-          if (check_redraw == 0) { _redraw_type = "none"; }
+          if (check_redraw == 0) { _damage = DAMAGE_NONE; }
         }
         else
         {
           retval = signals::keyRight;
-          _redraw_type = "entry";
+          _damage = DAMAGE_ENTRY;
           getting_input = false;
         }
         break;
       case KEY_HOME:
-        if (_cursidx == 0) { _redraw_type = "none"; }
+        if (_cursidx == 0) { _damage = DAMAGE_NONE; }
         _cursidx = 0;
         _firsttext = 0;
         break;
       case KEY_END:
         _cursidx = _entry.size();
         check_redraw = determineFirstText();
-        if (check_redraw == 0) { _redraw_type = "none"; }
+        if (check_redraw == 0) { _damage = DAMAGE_NONE; }
         break;
       case KEY_PPAGE:
         retval = signals::highlightPrevPage;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
       case KEY_NPAGE:
         retval = signals::highlightNextPage;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
       case KEY_UP:
       case MY_SHIFT_TAB:
         retval = signals::highlightPrev;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
       case KEY_DOWN:
       case MY_TAB:
         retval = signals::highlightNext;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
 
@@ -292,7 +293,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
     
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
 
@@ -300,7 +301,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         getting_input = false;
         break;
 
@@ -313,7 +314,7 @@ std::string TextInput::exec(int y_offset, MouseEvent * mevent)
           retval = handleMouseEvent(mevent, y_offset);
           if (retval == signals::mouseEvent)
           {
-            _redraw_type = "entry";
+            _damage = DAMAGE_ENTRY;
             getting_input = false;
           }
         }
@@ -6,6 +6,7 @@
 #include "InputItem.h"
 #include "ToggleInput.h"
 #include "MouseEvent.h"
+#include "FrameScheduler.h"
 
 /*******************************************************************************
 
@@ -37,7 +38,7 @@ Constructor
 *******************************************************************************/
 ToggleInput::ToggleInput()
 {
-  _redraw_type = "all";
+  _damage = DAMAGE_ALL;
   _item_type = "ToggleInput";
   _selectable = true;
   _name = "ToggleInput";
@@ -90,7 +91,7 @@ Draws input
 *******************************************************************************/
 void ToggleInput::draw(int y_offset, bool force, bool highlight)
 {
-  if (force) { _redraw_type = "all"; }
+  if (force) { _damage = DAMAGE_ALL; }
 
   if (highlight)
   {
@@ -98,14 +99,13 @@ void ToggleInput::draw(int y_offset, bool force, bool highlight)
       wattron(_win, A_REVERSE);
   }
 
-  if ( (_redraw_type == "all") || (_redraw_type == "entry") )
-    redrawEntry(y_offset);
-  if (_redraw_type == "all") { redrawText(y_offset); }
+  if (_damage & DAMAGE_ENTRY) { redrawEntry(y_offset); }
+  if (_damage & DAMAGE_LABEL) { redrawText(y_offset); }
   wmove(_win, _posy-y_offset, _posx+1);
 
   if (highlight)
     if (colors.turnOff(_win) != 0) { wattroff(_win, A_REVERSE); }
-  wrefresh(_win);
+  frame_scheduler.schedule(_win);
 }
 
 /*******************************************************************************
@@ -132,11 +132,11 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
     // Redraw
   
     draw(y_offset, false, true);
-    _redraw_type = "entry";
+    _damage = DAMAGE_ENTRY;
 
     // Get user input
 
-    switch (ch = getch()) {
+    switch (ch = frame_scheduler.getInput()) {
 
       // Enter key: return enter signal
 
@@ -144,7 +144,7 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
       case '\r':
       case KEY_ENTER: 
         retval = signals::keyEnter;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -152,51 +152,51 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
 
       case ' ':
         toggle();
-        _redraw_type = "entry";
+        _damage = DAMAGE_ENTRY;
         break;
 
       // Navigation keys
 
       case KEY_HOME:
         retval = signals::highlightFirst;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_END:
         retval = signals::highlightLast;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_PPAGE:
         retval = signals::highlightPrevPage;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_NPAGE:
         retval = signals::highlightNextPage;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_UP:
       case MY_SHIFT_TAB:
         retval = signals::highlightPrev;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_DOWN:
       case MY_TAB:
         retval = signals::highlightNext;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_RIGHT:
         retval = signals::keyRight;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
       case KEY_LEFT:
         retval = signals::keyLeft;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -204,7 +204,7 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
     
       case KEY_RESIZE:
         retval = signals::resize;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -212,7 +212,7 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
 
       case MY_ESC:
         retval = signals::quit;
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
 
@@ -225,17 +225,17 @@ std::string ToggleInput::exec(int y_offset, MouseEvent * mevent)
           retval = handleMouseEvent(mevent, y_offset);
           if (retval == signals::mouseEvent)
           {
-            _redraw_type = "all";
+            _damage = DAMAGE_ALL;
             getting_input = false;
           }
           else
-            _redraw_type = "entry";
+            _damage = DAMAGE_ENTRY;
         }
         break;
 
       default:
         retval = char(ch);
-        _redraw_type = "all";
+        _damage = DAMAGE_ALL;
         getting_input = false;
         break;
     }
@@ -4,20 +4,32 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <set>
+#include <cstdio>     // popen, pclose, remove
 #include <algorithm>  // sort
 #include <fstream>
-#include <atomic>
+#include <map>
+#include <unordered_map>
+#include <utility>    // pair, make_pair
 #include <ctime>      // strftime
+#include <unistd.h>   // access
 #include "DirListing.h"
 #include "ListItem.h"
 #include "BuildListItem.h"
 #include "string_util.h"
-#include "ShellReader.h"
+#include "MappedShellReader.h"
 #include "settings.h"
 #include "Blacklist.h"
 #include "IgnoreVersions.h"
+#include "RepoIndex.h"
+#include "ReadmeIndex.h"
+#include "InstalledPackages.h"
 #include "backend.h"
 
+#ifdef _OPENMP
+  #include <omp.h>    // omp_get_num_procs
+#endif
+
 #ifndef PACKAGE_DIR
   #define PACKAGE_DIR "/var/lib/pkgtools/packages"
 #endif
@@ -26,58 +38,106 @@ using namespace settings;
 
 Blacklist blacklist;
 IgnoreVersions ignore_versions;
+RepoIndex repo_index;
+ReadmeIndex readme_index;
+InstalledPackages installed_packages;
+
+// Hash table for looking up SlackBuilds by name, and the list it refers to
+
+static std::unordered_map<std::string, std::pair<int,int> > slackbuild_lookup;
+static const std::vector<std::vector<BuildListItem> > *lookup_list = NULL;
+
+// Whether the README index has been read since the repo was last read
+
+static bool readme_index_loaded = false;
 
 /*******************************************************************************
 
-Gets list of SlackBuilds by reading repo directory. Returns 0 if successful,
-1 if directory cannot be read, 2 if directory is empty.
+Creates a BuildListItem for a SlackBuild in the repository
 
 *******************************************************************************/
-int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds)
+static BuildListItem new_repo_build(const std::string & category,
+                                    const std::string & name)
 {
-  DirListing top_dir, category_dir;
+  BuildListItem build;
+
+  build.setName(name);
+  build.setCategory(category);
+  // Set ignore_versions pointer
+  build.setIgnoreVersions(&ignore_versions);
+  // Check if blacklisted by name at this point
+  build.setBlacklisted(blacklist.nameBlacklisted(build.name()));
+
+  return build;
+}
+
+/*******************************************************************************
+
+Number of worker threads to use for loading the repository and installed
+packages, from the jobs setting. 0 means one per processor.
+
+*******************************************************************************/
+int num_jobs()
+{
+#ifdef _OPENMP
+  if (jobs > 0) { return jobs; }
+  else { return omp_get_num_procs(); }
+#else
+  return 1;
+#endif
+}
+
+/*******************************************************************************
+
+Gets list of SlackBuilds by walking the repo directory tree. Categories are
+listed first and then scanned in parallel, each into its own slot, so the
+result is in the same order regardless of the number of threads. Returns 0 if
+successful, 1 if directory cannot be read, 2 if directory is empty.
+
+*******************************************************************************/
+static int walk_repo(std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  DirListing top_dir;
+  std::vector<std::string> categories;
   int stat;
-  unsigned int i, j, ncategories, nbuilds;
-  direntry cat_entry, build_entry;
+  unsigned int i, nentries, ncategories;
 
-  // Open top directory
+  // Open top directory and get list of categories
 
   stat = top_dir.setFromPath(repo_dir);
   if (stat == 1) { return stat; }
   
+  slackbuilds.resize(0); 
+  nentries = top_dir.size();
+  if (nentries == 0) { return 2; }
+  for ( i = 0; i < nentries; i++ )
+  {
+    if (top_dir(i).type == "dir") { categories.push_back(top_dir(i).name); }
+    else { break; }       // Directories are listed first, so we're done
+  }
+
   // Read SlackBuilds from each category
 
-  slackbuilds.resize(0); 
-  ncategories = top_dir.size();
-  if (ncategories == 0) { return 2; }
+  ncategories = categories.size();
+  slackbuilds.resize(ncategories);
+#pragma omp parallel for schedule(dynamic) num_threads(num_jobs())
   for ( i = 0; i < ncategories; i++ )
   {
-    cat_entry = top_dir(i);
-    if (cat_entry.type == "dir")
+    DirListing category_dir;
+    direntry build_entry;
+    unsigned int j, nbuilds;
+
+    category_dir.setFromPath(repo_dir + "/" + categories[i]);
+    nbuilds = category_dir.size();
+    slackbuilds[i].reserve(nbuilds);
+    for ( j = 0; j < nbuilds; j++ )
     {
-      std::vector<BuildListItem> cat_builds;
-      category_dir.setFromPath(cat_entry.path + "/" + cat_entry.name);
-      nbuilds = category_dir.size();
-      for ( j = 0; j < nbuilds; j++ )
-      {
-        build_entry = category_dir(j);
-        if (build_entry.type == "dir")
-        {
-          BuildListItem build;
-          build.setName(build_entry.name);
-          build.setProp("category", cat_entry.name);
-          // Set ignore_versions pointer
-          build.setIgnoreVersions(&ignore_versions);
-          // Check if blacklisted by name at this point
-          build.setBoolProp("blacklisted",
-                            blacklist.nameBlacklisted(build.name()));
-          cat_builds.push_back(build);
-        }
-        else { break; }   // Directories are listed first, so we're done
-      }
-      slackbuilds.push_back(cat_builds);
+      build_entry = category_dir(j);
+      if (build_entry.type == "dir")
+        slackbuilds[i].push_back(new_repo_build(categories[i],
+                                                build_entry.name));
+      else { break; }   // Directories are listed first, so we're done
     }
-    else { break; }       // Directories are listed first, so we're done
   }  
 
   return 0;
@@ -85,6 +145,272 @@ int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds)
 
 /*******************************************************************************
 
+Location of the repository index file for the current repo_dir. Each repo_dir
+gets its own file, so switching between configuration files does not
+invalidate the index.
+
+*******************************************************************************/
+static std::string repo_index_file()
+{
+  std::string fname;
+  unsigned int i, len;
+
+  fname = repo_dir;
+  len = fname.size();
+  for ( i = 0; i < len; i++ ) { if (fname[i] == '/') { fname[i] = '_'; } }
+
+  return "/var/lib/sboui/index/" + fname + ".idx";
+}
+
+// The README index is kept alongside
+
+static std::string readme_index_file()
+{
+  return repo_index_file() + ".readme";
+}
+
+/*******************************************************************************
+
+Whether the repository index can be written, e.g. not when running as a normal
+user
+
+*******************************************************************************/
+static bool repo_index_writable()
+{
+  if (access("/var/lib/sboui/index", F_OK) == 0)
+    return (access("/var/lib/sboui/index", W_OK) == 0);
+  else
+    return (access("/var/lib/sboui", W_OK) == 0);
+}
+
+/*******************************************************************************
+
+Gets list of SlackBuilds. Uses the repository index if it is up to date, so
+that the repository tree does not need to be walked; otherwise reads the repo
+directory and writes a new index if possible, so that a repository updated
+outside of sboui (e.g., with git pull or in an overlay) is only walked once.
+Also builds the name lookup table for find_slackbuild. Returns 0 if
+successful, 1 if directory cannot be read, 2 if directory is empty.
+
+*******************************************************************************/
+int read_repo(std::vector<std::vector<BuildListItem> > & slackbuilds)
+{
+  unsigned int i, j, ncategories;
+  int check;
+  const indexcategory *cat;
+  const indexentry *entry;
+
+  readme_index_loaded = false;
+  if (repo_index.read(repo_index_file(), repo_dir) != 0)
+  {
+    check = walk_repo(slackbuilds);
+    if (check == 0)
+    {
+      index_slackbuilds(slackbuilds);
+      if (repo_index_writable()) { update_repo_index(); }
+    }
+    return check;
+  }
+
+  slackbuilds.resize(0);
+  ncategories = repo_index.numCategories();
+  if (ncategories == 0) { return 2; }
+  slackbuilds.resize(ncategories);
+#pragma omp parallel for schedule(dynamic) private(j,cat,entry) \
+                         num_threads(num_jobs())
+  for ( i = 0; i < ncategories; i++ )
+  {
+    cat = &repo_index.category(i);
+    slackbuilds[i].reserve(cat->nbuilds);
+    for ( j = cat->first; j < cat->first + cat->nbuilds; j++ )
+    {
+      entry = &repo_index.build(j);
+      slackbuilds[i].push_back(new_repo_build(entry->category, entry->name));
+    }
+  }
+
+  index_slackbuilds(slackbuilds);
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Regenerates the README index for the given SlackBuilds and writes it next to
+the repository index. As in update_repo_index, READMEs that have not been
+modified since the README index on disk was written, and are not in
+changed_builds, are taken from it instead of being read again. Returns 0 on
+success or 1 if the index cannot be written.
+
+*******************************************************************************/
+static int update_readme_index(const std::vector<const BuildListItem *> &
+                               builds,
+                               const std::set<std::string> * changed_builds)
+{
+  std::vector<std::vector<std::string> > words, old_words;
+  std::vector<int> previous;
+  unsigned int i, nbuilds;
+  int doc;
+  ReadmeIndex old_index;
+  bool reuse;
+
+  nbuilds = builds.size();
+  previous.assign(nbuilds, -1);
+  reuse = (old_index.read(readme_index_file(), repo_dir, false) == 0);
+  if (reuse)
+  {
+    old_index.documentWords(old_words);
+    for ( i = 0; i < nbuilds; i++ )
+    {
+      if ( (changed_builds != NULL) &&
+           (changed_builds->count(builds[i]->category() + "/" +
+                                  builds[i]->name()) != 0) ) { continue; }
+      doc = old_index.docId(builds[i]->category(), builds[i]->name());
+      if ( (doc != -1) && (old_index.docUpToDate(doc)) ) { previous[i] = doc; }
+    }
+  }
+
+  // Read READMEs in parallel, then add to the index in repository order
+
+  words.resize(nbuilds);
+#pragma omp parallel for schedule(dynamic) num_threads(num_jobs())
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (previous[i] != -1) { words[i].swap(old_words[previous[i]]); }
+    else
+      ReadmeIndex::readWords(repo_dir + "/" + builds[i]->category() + "/" +
+                             builds[i]->name() + "/README", words[i]);
+  }
+
+  readme_index.clear();
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    readme_index.addReadme(builds[i]->category(), builds[i]->name(), words[i]);
+  }
+  readme_index.stamp(repo_dir);
+  readme_index_loaded = true;
+
+  if (readme_index.write(readme_index_file()) != 0) { return 1; }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Regenerates the repository index by reading every SlackBuild in the repo and
+writes it to /var/lib/sboui/index. SlackBuilds that have not been modified since
+the index on disk was written are copied from it instead of being read again,
+except those listed in changed_builds (category/name), e.g. the SlackBuilds
+changed by a sync. Returns 0 on success, 1 if the repo cannot be read, or 2 if
+the index cannot be written.
+
+*******************************************************************************/
+int update_repo_index(const std::set<std::string> * changed_builds)
+{
+  std::vector<std::vector<BuildListItem> > slackbuilds;
+  std::vector<const BuildListItem *> builds;
+  std::vector<const indexentry *> previous;
+  const indexentry *entry;
+  std::vector<std::string> versions, reqs, buildnums, shortdescs;
+  std::vector<int> checks;
+  unsigned int i, j, ncategories, nbuilds;
+  int check;
+  DirListing listing;
+  RepoIndex old_index;
+  bool reuse;
+
+  // Make sure get_repo_info reads from the repository, not the old index
+
+  repo_index.clear();
+  check = walk_repo(slackbuilds);
+  if (check == 1) { return 1; }
+
+  ncategories = slackbuilds.size();
+  for ( i = 0; i < ncategories; i++ )
+  {
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ ) { builds.push_back(&slackbuilds[i][j]); }
+  }
+  nbuilds = builds.size();
+
+  // Entries that can be kept from the old index
+
+  previous.assign(nbuilds, NULL);
+  reuse = (old_index.read(repo_index_file(), repo_dir, false) == 0);
+  if (reuse)
+  {
+    for ( i = 0; i < nbuilds; i++ )
+    {
+      if ( (changed_builds != NULL) &&
+           (changed_builds->count(builds[i]->category() + "/" +
+                                  builds[i]->name()) != 0) ) { continue; }
+      entry = old_index.find(builds[i]->category(), builds[i]->name());
+      if ( (entry != NULL) && (old_index.buildUpToDate(*entry)) )
+        previous[i] = entry;
+    }
+  }
+
+  // Read info files in parallel, then add to the index in repository order
+
+  versions.resize(nbuilds);
+  reqs.resize(nbuilds);
+  buildnums.resize(nbuilds);
+  shortdescs.resize(nbuilds);
+  checks.resize(nbuilds);
+#pragma omp parallel for schedule(dynamic) num_threads(num_jobs())
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    if (previous[i] != NULL)
+    {
+      versions[i] = previous[i]->version;
+      reqs[i] = previous[i]->reqs;
+      buildnums[i] = previous[i]->buildnum;
+      shortdescs[i] = previous[i]->shortdesc;
+      checks[i] = previous[i]->status;
+    }
+    else
+    {
+      checks[i] = get_repo_info(*builds[i], versions[i], reqs[i],
+                                buildnums[i]);
+      get_short_description(*builds[i], shortdescs[i]);
+    }
+  }
+  for ( i = 0; i < nbuilds; i++ )
+  {
+    repo_index.addBuild(builds[i]->category(), builds[i]->name(),
+                        versions[i], reqs[i], buildnums[i], shortdescs[i],
+                        checks[i]);
+  }
+  repo_index.stamp(repo_dir);
+
+  if (listing.createFromPath("/var/lib/sboui/index") != 0) { return 2; }
+  if (repo_index.write(repo_index_file()) != 0) { return 2; }
+  if (update_readme_index(builds, changed_builds) != 0)
+    return 2;
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Makes sure the README index is loaded, reading it from disk the first time it
+is needed after the repo is read. Returns true if it is up to date with the
+repository and can be used for searching.
+
+*******************************************************************************/
+bool readme_index_ready()
+{
+  if (! readme_index_loaded)
+  {
+    readme_index.read(readme_index_file(), repo_dir);
+    readme_index_loaded = true;
+  }
+
+  return readme_index.valid();
+}
+
+/*******************************************************************************
+
 Reads build options in /var/lib/sboui/buildopts
 
 *******************************************************************************/
@@ -122,7 +448,7 @@ int read_buildopts(std::vector<std::vector<BuildListItem> > & slackbuilds)
     }
     buildname = listing(k).name.substr(0,ext_idx);
     if (find_slackbuild(buildname, slackbuilds, i, j) == 0)
-      slackbuilds[i][j].setProp("build_options", buildopts);
+      slackbuilds[i][j].setBuildOptions(buildopts);
     file.close();
   }
 
@@ -131,8 +457,42 @@ int read_buildopts(std::vector<std::vector<BuildListItem> > & slackbuilds)
 
 /*******************************************************************************
 
+Builds the name lookup table used by find_slackbuild. The table stays valid as
+long as slackbuilds is not reordered or resized, so it only needs to be rebuilt
+when the list is read again.
+
+*******************************************************************************/
+void index_slackbuilds(const std::vector<std::vector<BuildListItem> > &
+                       slackbuilds)
+{
+  unsigned int i, j, ncategories, nbuilds, ntotal;
+
+  ncategories = slackbuilds.size();
+  ntotal = 0;
+  for ( i = 0; i < ncategories; i++ ) { ntotal += slackbuilds[i].size(); }
+
+  slackbuild_lookup.clear();
+  slackbuild_lookup.reserve(ntotal);
+  for ( i = 0; i < ncategories; i++ )
+  {
+    nbuilds = slackbuilds[i].size();
+    for ( j = 0; j < nbuilds; j++ )
+    {
+      // If the same name is in more than one category, keep the first, as
+      // the category-by-category search would
+
+      slackbuild_lookup.insert(std::make_pair(slackbuilds[i][j].name(),
+                                              std::make_pair(int(i), int(j))));
+    }
+  }
+  lookup_list = &slackbuilds;
+}
+
+/*******************************************************************************
+
 Finds a SlackBuild by name in the _slackbuilds list. Returns 0 if found, 1 if
-not found, and also sets indices in list where it was found.
+not found, and also sets indices in list where it was found. Uses the lookup
+table if it was built for this list; otherwise searches each category.
  
 *******************************************************************************/
 int find_slackbuild(const std::string & name,
@@ -140,14 +500,32 @@ int find_slackbuild(const std::string & name,
                     int & idx0, int & idx1)
 {
   int i, ncategories, nbuilds, check, lbound, rbound;
-  std::atomic<bool> found(false);
+  std::unordered_map<std::string, std::pair<int,int> >::const_iterator it;
+
+  if (lookup_list == &slackbuilds)
+  {
+    it = slackbuild_lookup.find(name);
+    if (it == slackbuild_lookup.end()) { return 1; }
+
+    // Guard against the list having changed since it was indexed
+
+    i = it->second.first;
+    if ( (i < int(slackbuilds.size())) &&
+         (it->second.second < int(slackbuilds[i].size())) &&
+         (slackbuilds[i][it->second.second].name() == name) )
+    {
+      idx0 = i;
+      idx1 = it->second.second;
+      return 0;
+    }
+  }
+
+  // Note: this is called from inside the parallel loop in determine_installed,
+  // so it must not start a parallel region of its own.
 
   ncategories = slackbuilds.size();
-#pragma omp parallel for private(i,nbuilds,lbound,rbound,check)
   for ( i = 0; i < ncategories; i++ )
   {
-    if (found)
-      continue;
     nbuilds = slackbuilds[i].size();
     lbound = 0;
     rbound = nbuilds-1;
@@ -155,14 +533,11 @@ int find_slackbuild(const std::string & name,
     if (check == 0)
     {
       idx0 = i;
-      found = true;
+      return 0;
     }
   }
 
-  if (found)
-    return 0;
-  else
-    return 1;
+  return 1;
 }
 
 /*******************************************************************************
@@ -232,26 +607,24 @@ std::vector<std::string> list_installed_packages()
 
 /*******************************************************************************
 
-Checks if a SlackBuild is installed and sets info if so.
+Checks if a SlackBuild is installed and sets info if so. Uses the installed
+package database, which must have been read by determine_installed.
 
 *******************************************************************************/
-bool check_installed(const BuildListItem & build,
-                     const std::vector<std::string> & installedpkgs,
-                     std::string & pkg, std::string & version,
-                     std::string & arch, std::string & pkgbuild)
+bool check_installed(const BuildListItem & build, std::string & pkg,
+                     std::string & version, std::string & arch,
+                     std::string & pkgbuild)
 {
-  std::string name;
-  unsigned int ninstalled, i;
+  const installedpkg *installed;
 
-  ninstalled = installedpkgs.size();
-  for ( i = 0; i < ninstalled; i++ )
+  installed = installed_packages.find(build.name());
+  if (installed != NULL)
   {
-    get_pkg_info(installedpkgs[i], name, version, arch, pkgbuild);
-    if (name == build.name())
-    {
-      pkg = installedpkgs[i];
-      return true;
-    }
+    pkg = installed->pkg;
+    version = installed->version;
+    arch = installed->arch;
+    pkgbuild = installed->build;
+    return true;
   }
     
   pkg = "";
@@ -269,18 +642,34 @@ Gets SlackBuild requirements (dependencies) as string
 *******************************************************************************/
 int get_reqs(const BuildListItem & build, std::string & reqs)
 {
-  ShellReader reader;
+  MappedShellReader reader;
+  std::vector<shellvar> vars(1);
   std::string info_file;
   int check;
+  const indexentry *entry;
+
+  // Use the repository index if possible. If there was a problem reading
+  // this SlackBuild when indexing, fall through so the error is reported the
+  // same way as without the index.
+
+  entry = repo_index.find(build.category(), build.name());
+  if ( (entry != NULL) && (entry->status == 0) )
+  {
+    reqs = entry->reqs;
+    return 0;
+  }
 
-  info_file = repo_dir + "/" + build.getProp("category") + "/" +
+  info_file = repo_dir + "/" + build.category() + "/" +
               build.name() + "/" + build.name() + ".info";
 
   reqs = "";
   check = reader.open(info_file);
   if (check == 0)
   {
-    reader.read("REQUIRES", reqs);
+    vars[0].name = "REQUIRES";
+    vars[0].default_var = false;
+    reader.read(vars);
+    reqs = vars[0].value.str();
     reader.close();
   }
 
@@ -289,38 +678,104 @@ int get_reqs(const BuildListItem & build, std::string & reqs)
 
 /*******************************************************************************
 
-Gets SlackBuild version and reqs from repository
-Note: this function seems to be the biggest bottleneck for speed.
+Gets the short description of a SlackBuild from the repository index, or from
+the first line of its slack-desc (the part in parentheses after the name) if
+the index is not available. Returns 0 on success or 1 if slack-desc cannot be
+read.
+
+*******************************************************************************/
+int get_short_description(const BuildListItem & build, std::string & desc)
+{
+  std::ifstream file;
+  std::string line, prefix;
+  std::size_t lparen, rparen;
+  const indexentry *entry;
+
+  entry = repo_index.find(build.category(), build.name());
+  if (entry != NULL)
+  {
+    desc = entry->shortdesc;
+    return 0;
+  }
+
+  desc = "";
+  file.open((repo_dir + "/" + build.category() + "/" + build.name() +
+             "/slack-desc").c_str());
+  if (not file.is_open()) { return 1; }
+
+  prefix = build.name() + ":";
+  while (std::getline(file, line))
+  {
+    if (line.compare(0, prefix.size(), prefix) != 0) { continue; }
+    desc = trim(line.substr(prefix.size()));
+    lparen = desc.find('(');
+    rparen = desc.rfind(')');
+    if ( (lparen != std::string::npos) && (rparen != std::string::npos) &&
+         (rparen > lparen) )
+      desc = desc.substr(lparen+1, rparen-lparen-1);
+    break;
+  }
+  file.close();
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Gets SlackBuild version and reqs from repository index, or from the .info and
+.SlackBuild files if the index is not available.
+Note: reading the files seems to be the biggest bottleneck for speed.
 
 *******************************************************************************/
 int get_repo_info(const BuildListItem & build, std::string & available_version,
                   std::string & reqs, std::string & available_buildnum) 
 {
-  ShellReader reader;
+  MappedShellReader reader;
+  std::vector<shellvar> infovars(2), buildvars(1);
   std::string info_file, slackbuild_file;
   int check;
+  const indexentry *entry;
+
+  // Use the repository index if possible
+
+  entry = repo_index.find(build.category(), build.name());
+  if (entry != NULL)
+  {
+    available_version = entry->version;
+    reqs = entry->reqs;
+    available_buildnum = entry->buildnum;
+    return entry->status;
+  }
 
-  // Read available version and requirements from .info file
+  // Read available version and requirements from .info file in one pass
 
-  info_file = repo_dir + "/" + build.getProp("category") + "/" +
+  info_file = repo_dir + "/" + build.category() + "/" +
               build.name() + "/" + build.name() + ".info";
   check = reader.open(info_file);
   if (check == 0)
   { 
-    reader.read("VERSION", available_version);
-    reader.read("REQUIRES", reqs);
+    infovars[0].name = "VERSION";
+    infovars[0].default_var = false;
+    infovars[1].name = "REQUIRES";
+    infovars[1].default_var = false;
+    reader.read(infovars);
+    available_version = infovars[0].value.str();
+    reqs = infovars[1].value.str();
     reader.close();
   }
   else { return check; }
 
   // Read build number from .SlackBuild file
 
-  slackbuild_file = repo_dir + "/" + build.getProp("category") + "/" +
+  slackbuild_file = repo_dir + "/" + build.category() + "/" +
                     build.name() + "/" + build.name() + ".SlackBuild";
   check = reader.open(slackbuild_file);
   if (check == 0)
   { 
-    reader.read("BUILD", available_buildnum, true);
+    buildvars[0].name = "BUILD";
+    buildvars[0].default_var = true;
+    reader.read(buildvars);
+    available_buildnum = buildvars[0].value.str();
     reader.close();
   }
 
@@ -348,61 +803,89 @@ the second.
 bool compare_builds_by_category(const BuildListItem *item1,
                                 const BuildListItem *item2)
 {
-  return item1->getProp("category") < item2->getProp("category");
+  return item1->category() < item2->category();
 }
  
 /*******************************************************************************
 
 Determines which SlackBuilds are installed and sets related properties. Also
-checks for invalid names and missing .info files.
+checks for invalid names and missing .info files. Reads the installed package
+database, matches installed packages to SlackBuilds in parallel, and then sets
+up each installed SlackBuild in parallel. Missing .info files are reported in
+repository order, regardless of the number of threads.
 
 *******************************************************************************/
 void determine_installed(std::vector<std::vector<BuildListItem> > & slackbuilds,
                          std::vector<std::string> & pkg_errors,
                          std::vector<std::string> & missing_info)
 {
-  std::vector<std::string> installedpkgs;
-  std::string name, version, arch, build, curcategory, response;
-  unsigned int ninstalled, k;
-  int i, j, check, pkgcheck, infocheck;
+  std::vector<const installedpkg *> installedpkgs, matchedpkgs;
+  std::vector<std::pair<int,int> > positions;
+  std::vector<int> idx0, idx1, infochecks;
+  std::map<std::pair<int,int>, unsigned int> matches;
+  std::map<std::pair<int,int>, unsigned int>::iterator it;
+  const installedpkg *pkg;
+  unsigned int ninstalled, nmatched, k, m;
+  int i, j;
 
   pkg_errors.resize(0);
   missing_info.resize(0);
-  installedpkgs = list_installed_packages();
+  installed_packages.read(PACKAGE_DIR);
+  pkg_errors = installed_packages.invalid();
+  installedpkgs = installed_packages.list();
   ninstalled = installedpkgs.size();
-#pragma omp parallel for private(k,pkgcheck,name,version,arch,build,check,i,j,\
-                                 infocheck)
+  idx0.assign(ninstalled, -1);
+  idx1.assign(ninstalled, -1);
+
+  // Find the matching SlackBuilds
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_jobs())
   for ( k = 0; k < ninstalled; k++ )
   {
-    // Check for invalid package names
+    find_slackbuild(installedpkgs[k]->name, slackbuilds, idx0[k], idx1[k]);
+  }
 
-    pkgcheck = get_pkg_info(installedpkgs[k], name, version, arch, build);
-    if (pkgcheck != 0)
-    {
-#pragma omp critical
-      { pkg_errors.push_back(installedpkgs[k]); }
-      continue;
-    }
-    check = find_slackbuild(name, slackbuilds, i, j);
-    if (check == 0)
-    {
-      slackbuilds[i][j].setBoolProp("installed", true);
-      slackbuilds[i][j].setProp("installed_version", version);
-      slackbuilds[i][j].parseBuildNum(build);
-      slackbuilds[i][j].setProp("package_name", installedpkgs[k]);
+  // Sort matches in repository order
 
-      slackbuilds[i][j].setBoolProp("blacklisted",
-                        blacklist.blacklisted(installedpkgs[k], name, version,
-                                              arch, build));
+  for ( k = 0; k < ninstalled; k++ )
+  {
+    if (idx0[k] != -1) { matches[std::make_pair(idx0[k], idx1[k])] = k; }
+  }
+  for ( it = matches.begin(); it != matches.end(); it++ )
+  {
+    positions.push_back(it->first);
+    matchedpkgs.push_back(installedpkgs[it->second]);
+  }
 
-      // Read props, set upgradable status, and check for missing .info file
+  // Set properties of installed SlackBuilds
 
-      infocheck = slackbuilds[i][j].readPropsFromRepo();
-      if (infocheck != 0)
-#pragma omp critical
-        { missing_info.push_back(slackbuilds[i][j].name()); }
-    }
+  nmatched = matchedpkgs.size();
+  infochecks.resize(nmatched);
+#pragma omp parallel for schedule(dynamic) private(i,j,pkg) \
+                         num_threads(num_jobs())
+  for ( m = 0; m < nmatched; m++ )
+  {
+    pkg = matchedpkgs[m];
+    i = positions[m].first;
+    j = positions[m].second;
+    slackbuilds[i][j].setInstalled(true);
+    slackbuilds[i][j].setInstalledVersion(pkg->version);
+    slackbuilds[i][j].parseBuildNum(pkg->build);
+    slackbuilds[i][j].setPackageName(pkg->pkg);
+
+    slackbuilds[i][j].setBlacklisted(blacklist.blacklisted(pkg->pkg,
+                                      pkg->name, pkg->version, pkg->arch,
+                                      pkg->build));
+
+    // Read props, set upgradable status, and check for missing .info file
+
+    infochecks[m] = slackbuilds[i][j].readPropsFromRepo();
   } 
+
+  for ( m = 0; m < nmatched; m++ )
+  {
+    if (infochecks[m] != 0) { missing_info.push_back(matchedpkgs[m]->name); }
+  }
 }
 
 /*******************************************************************************
@@ -435,25 +918,111 @@ int run_command(const std::string & cmd)
 
 /*******************************************************************************
 
-Installs a SlackBuild
+Build options to put in front of a package manager command. The built-in
+package manager also gets them in SBOUI_BUILDOPTS, so that it can tell packages
+built with different options apart.
 
 *******************************************************************************/
-int install_slackbuild(BuildListItem & build)
+static std::string build_options_env(const BuildListItem & build)
 {
-  std::string cmd;
-  int check;
-  std::vector<std::string> installedpkgs;
+  std::string env;
 
-  cmd = install_vars + " " + build.buildOptionsEnv() + " " + install_cmd
-      + " " + build.name() + " " + install_clos;
-  check = run_command(cmd);
-  if (check != 0) { return check; }
+  env = build.buildOptionsEnv();
+  if (package_manager == "built-in")
+    env += " SBOUI_BUILDOPTS=" + shell_quote(build.buildOptionsEnv());
 
-  // Check to make sure it was actually installed and update properties
+  return env;
+}
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  if (build.getBoolProp("installed"))
+/*******************************************************************************
+
+Gets the package manager command to install, upgrade, or reinstall a SlackBuild
+
+*******************************************************************************/
+std::string install_command(const BuildListItem & build,
+                            const std::string & action)
+{
+  if (action == "Upgrade")
+    return upgrade_vars + " " + build_options_env(build) + " " + upgrade_cmd
+         + " " + build.name() + " " + upgrade_clos;
+  else if (action == "Reinstall")
+    return install_vars + " " + build_options_env(build) + " " + reinstall_cmd
+         + " " + build.name() + " " + install_clos;
+  else
+    return install_vars + " " + build_options_env(build) + " " + install_cmd
+         + " " + build.name() + " " + install_clos;
+}
+
+/*******************************************************************************
+
+Command for one step of installing, upgrading, or reinstalling a SlackBuild
+with the built-in package manager: "fetch", "build", or "install" (the package
+made by the build step). The sboui-backend executable is taken from the
+configured install or upgrade command, and every step gets the same variables
+and options, so that the build and install steps agree on OUTPUT, TMP, etc.
+
+*******************************************************************************/
+std::string pipeline_command(const BuildListItem & build,
+                             const std::string & action,
+                             const std::string & stage)
+{
+  std::string cmd, vars, clos, backend;
+  std::size_t pos;
+
+  if (action == "Upgrade")
+  {
+    cmd = trim(upgrade_cmd);
+    vars = upgrade_vars;
+    clos = upgrade_clos;
+  }
+  else
+  {
+    cmd = trim(install_cmd);
+    vars = install_vars;
+    clos = install_clos;
+  }
+
+  pos = cmd.find_first_of(' ');
+  if (pos != std::string::npos) { backend = cmd.substr(0, pos); }
+  else { backend = cmd; }
+
+  if (stage == "fetch")
+    return vars + " " + backend + " fetch " + build.name() + " " + clos;
+  else if (stage == "build")
+    return vars + " " + build_options_env(build) + " " + backend + " build "
+         + build.name() + " " + clos;
+  else
+    return vars + " " + backend + " install --built -f " + build.name() + " "
+         + clos;
+}
+
+/*******************************************************************************
+
+Checks that an install, upgrade, or reinstall command worked and updates
+properties. If an upgrade didn't work (maybe package manager doesn't think it's
+upgradable), reinstalls instead, or treats it as an error if reinstall is false
+(e.g., when other builds are running in parallel). Returns 0 on success or
+nonzero on error.
+
+*******************************************************************************/
+int check_install(BuildListItem & build, const std::string & action,
+                  bool reinstall)
+{
+  installed_packages.update(build.name());
+  build.readInstalledProps();
+
+  if (action == "Upgrade")
+  {
+    build.readPropsFromRepo();
+    if (build.upgradable())
+    {
+      if (reinstall) { return reinstall_slackbuild(build); }
+      return 1;
+    }
+    return 0;
+  }
+
+  if (build.installed())
   {
     build.readPropsFromRepo();
     return 0;
@@ -463,33 +1032,32 @@ int install_slackbuild(BuildListItem & build)
 
 /*******************************************************************************
 
-Upgrades a SlackBuild
+Installs a SlackBuild
 
 *******************************************************************************/
-int upgrade_slackbuild(BuildListItem & build)
+int install_slackbuild(BuildListItem & build)
 {
-  std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
 
-  cmd = upgrade_vars + " " + build.buildOptionsEnv() + " " + upgrade_cmd
-      + " " + build.name() + " " + upgrade_clos;
-  check = run_command(cmd);
+  check = run_command(install_command(build, "Install"));
   if (check != 0) { return check; }
 
-  // If upgrade didn't work (maybe package manager doesn't think it's 
-  //  upgradable), reinstall instead
+  return check_install(build, "Install");
+}
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  build.readPropsFromRepo();
-  if (build.getBoolProp("upgradable"))
-  {
-    check = reinstall_slackbuild(build); 
-    if (check != 0) { return check; }
-  }
+/*******************************************************************************
 
-  return 0;
+Upgrades a SlackBuild
+
+*******************************************************************************/
+int upgrade_slackbuild(BuildListItem & build)
+{
+  int check;
+
+  check = run_command(install_command(build, "Upgrade"));
+  if (check != 0) { return check; }
+
+  return check_install(build, "Upgrade");
 }
 
 /*******************************************************************************
@@ -499,25 +1067,12 @@ Reinstalls a SlackBuild
 *******************************************************************************/
 int reinstall_slackbuild(BuildListItem & build)
 {
-  std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
 
-  cmd = install_vars + " " + build.buildOptionsEnv() + " " + reinstall_cmd
-      + " " + build.name() + " " + install_clos;
-  check = run_command(cmd);
+  check = run_command(install_command(build, "Reinstall"));
   if (check != 0) { return check; }
 
-  // Check to make sure it was actually installed and update properties
-
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  if (build.getBoolProp("installed"))
-  {
-    build.readPropsFromRepo();
-    return 0;
-  }
-  else { return 1; }
+  return check_install(build, "Reinstall");
 }
 
 /*******************************************************************************
@@ -529,17 +1084,16 @@ int remove_slackbuild(BuildListItem & build)
 {
   std::string cmd;
   int check;
-  std::vector<std::string> installedpkgs;
 
-  cmd = "removepkg " + build.getProp("package_name");
+  cmd = "removepkg " + build.packageName();
   check = run_command(cmd);
   if (check != 0) { return check; }
 
   // Check to make sure it was actually removed
 
-  installedpkgs = list_installed_packages();
-  build.readInstalledProps(installedpkgs);
-  if (build.getBoolProp("installed")) { return 1; }
+  installed_packages.update(build.name());
+  build.readInstalledProps();
+  if (build.installed()) { return 1; }
   else { return 0; }
 }
 
@@ -553,7 +1107,7 @@ int view_readme(const BuildListItem & build)
   std::string cmd, response;
   int retval;
 
-  cmd = viewer + " " + repo_dir + "/" + build.getProp("category") + "/"
+  cmd = viewer + " " + repo_dir + "/" + build.category() + "/"
                                       + build.name() + "/" + "README";
   retval = run_command(cmd);
   if (retval != 0)
@@ -616,14 +1170,131 @@ int view_notes(const BuildListItem & build)
 
 /*******************************************************************************
 
-Syncs/updates SlackBuilds repository
+Gets category/name of the SlackBuild that a path in the repository (as listed
+by git diff) belongs to. Returns false if the path is not in a SlackBuild
+directory.
+
+*******************************************************************************/
+static bool slackbuild_of_path(const std::string & path, std::string & build)
+{
+  std::size_t slashpos;
+
+  slashpos = path.find('/');
+  if (slashpos == std::string::npos) { return false; }
+  slashpos = path.find('/', slashpos+1);
+  if (slashpos == std::string::npos) { return false; }
+  build = path.substr(0, slashpos);
+
+  return true;
+}
+
+/*******************************************************************************
+
+Writes the manifest of paths changed by a sync, from git diff between the old
+and new HEAD, to /var/lib/sboui/last-sync-changes.txt. The first line has the
+old and new HEAD. Also returns the changed SlackBuilds (category/name). Returns
+0 on success, or 1 if the changes could not be determined (e.g., the repo is
+not a git repo, or the old commit is gone after a fresh clone).
+
+*******************************************************************************/
+static const std::string sync_changes_file =
+                                      "/var/lib/sboui/last-sync-changes.txt";
+
+static int write_sync_changes(const std::string & old_head,
+                              const std::string & new_head,
+                              std::set<std::string> & changed_builds)
+{
+  std::ofstream file;
+  std::string cmd, path, build;
+  FILE *pipe;
+  char buffer[4096];
+  int check;
+
+  changed_builds.clear();
+  std::remove(sync_changes_file.c_str());
+  if ( (old_head == "") || (new_head == "") ) { return 1; }
+
+  file.open(sync_changes_file.c_str());
+  if (not file.is_open()) { return 1; }
+  file << old_head << " " << new_head << std::endl;
+
+  cmd = "git -C \"" + repo_dir + "\" diff --name-only " + old_head + " "
+      + new_head + " 2> /dev/null";
+  pipe = popen(cmd.c_str(), "r");
+  if (pipe == NULL)
+  {
+    file.close();
+    std::remove(sync_changes_file.c_str());
+    return 1;
+  }
+  while (fgets(buffer, sizeof(buffer), pipe) != NULL)
+  {
+    path = trim(std::string(buffer));
+    file << path << std::endl;
+    if (slackbuild_of_path(path, build)) { changed_builds.insert(build); }
+  }
+  check = pclose(pipe);
+  file.close();
+
+  if ( (check != 0) || file.fail() )
+  {
+    changed_builds.clear();
+    std::remove(sync_changes_file.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Reads the SlackBuilds (category/name) changed by the last sync from the
+manifest written by sync_repo. Returns 0 on success, or 1 if there is no
+manifest or it does not match the current state of the repository.
+
+*******************************************************************************/
+int read_sync_changes(std::vector<std::string> & changed_builds)
+{
+  std::ifstream file;
+  std::string line, build;
+  std::vector<std::string> heads;
+  std::set<std::string> builds;
+
+  changed_builds.resize(0);
+  file.open(sync_changes_file.c_str());
+  if (not file.is_open()) { return 1; }
+
+  std::getline(file, line);
+  heads = split(trim(line));
+  if ( (heads.size() != 2) || (heads[1] != RepoIndex::gitHead(repo_dir)) )
+  {
+    file.close();
+    return 1;
+  }
+  while (std::getline(file, line))
+  {
+    if (slackbuild_of_path(trim(line), build)) { builds.insert(build); }
+  }
+  file.close();
+
+  changed_builds.assign(builds.begin(), builds.end());
+
+  return 0;
+}
+
+/*******************************************************************************
+
+Syncs/updates SlackBuilds repository. For git repositories, also records which
+paths changed, so that only the changed SlackBuilds need to be read again.
 
 *******************************************************************************/
 int sync_repo(bool interactive)
 { 
-  int retval;
-  std::string response;
+  int retval, check;
+  std::string response, old_head;
+  std::set<std::string> changed_builds;
 
+  old_head = RepoIndex::gitHead(repo_dir);
   retval = run_command(sync_cmd);
 
   // Record update time
@@ -654,6 +1325,21 @@ int sync_repo(bool interactive)
       std::cout << "Warning: unable to save update time to "
                 << "/var/lib/sboui/last-sync.txt." << std::endl;
     }
+
+    // Regenerate repository index so that startup doesn't need to read
+    // the repository tree
+
+    std::cout << "Updating repository index ..." << std::endl;
+    if (write_sync_changes(old_head, RepoIndex::gitHead(repo_dir),
+                           changed_builds) == 0)
+      check = update_repo_index(&changed_builds);
+    else
+      check = update_repo_index();
+    if (check != 0)
+    {
+      std::cout << "Warning: unable to update repository index in "
+                << "/var/lib/sboui/index." << std::endl;
+    }
   }
 
   if (interactive)
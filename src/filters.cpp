@@ -1,44 +1,22 @@
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <curses.h>
 #include "BuildListItem.h"
 #include "CategoryListItem.h"
 #include "CategoryListBox.h"
 #include "BuildListBox.h"
+#include "BuildSet.h"
+#include "BuildIndex.h"
 #include "string_util.h"
 #include "settings.h"   // repo_dir
+#include "DependencyGraph.h"   // dependency_graph
+#include "backend.h"        // readme_index
+#include "FuzzyIndex.h"
 #include "filters.h"
 
 /*******************************************************************************
 
-Filtering functions that may be passed to filter_by_func
-
-*******************************************************************************/
-bool any_build(const BuildListItem & build) { return true; }
-bool build_is_installed(const BuildListItem & build)
-{
-  return build.getBoolProp("installed");
-}
-bool build_is_upgradable(const BuildListItem & build)
-{
-  return build.getBoolProp("upgradable");
-}
-bool build_is_tagged(const BuildListItem & build)
-{
-  return build.getBoolProp("tagged");
-}
-bool build_is_blacklisted(const BuildListItem & build)
-{
-  return build.getBoolProp("blacklisted");
-}
-bool build_has_buildoptions(const BuildListItem & build)
-{
-  if (build.getProp("build_options") != "") { return true; }
-  else { return false; }
-}
-
-/*******************************************************************************
-
 Creates a list of installed packages sorted by name within each category
 
 *******************************************************************************/
@@ -54,7 +32,7 @@ std::vector<BuildListItem *> list_installed(
     nbuilds = slackbuilds[i].size();
     for ( j = 0; j < nbuilds; j++ )
     {
-      if (slackbuilds[i][j].getBoolProp("installed"))
+      if (slackbuilds[i][j].installed())
         installedlist.push_back(&slackbuilds[i][j]);
     }
   }
@@ -64,348 +42,371 @@ std::vector<BuildListItem *> list_installed(
 
 /*******************************************************************************
 
-Creates list of installed SlackBuilds that are not required by any other
-installed SlackBuild
+Adds the empty list shown when nothing passes a filter
 
 *******************************************************************************/
-std::vector<BuildListItem *> list_nondeps(
-                         std::vector<std::vector<BuildListItem> > & slackbuilds)
+static void add_empty_list(WINDOW *blistboxwin,
+                           std::vector<BuildListBox> & blistboxes)
 {
-  std::vector<BuildListItem *> installedlist, nondeplist;
-  unsigned int i, j, k, ninstalled, ndeps;
-  bool isdep;
-  std::vector<std::string> deplist;
+  BuildListBox initlistbox;
 
-  installedlist = list_installed(slackbuilds);
+  initlistbox.setWindow(blistboxwin);
+  initlistbox.setActivated(false);
+  initlistbox.setName("SlackBuilds");
+  blistboxes.push_back(initlistbox);
+}
+
+/*******************************************************************************
 
-  // N^2 (max) loop through installed packages to see which are dependencies
+Sets up lists showing the SlackBuilds in a set. categories are all categories
+in the repository, in the order of the index. The matching categories, their
+tag state, and the number of matches are found right away from the set, but
+each BuildListBox is only filled when it is first displayed, so mask must not
+change as long as the lists are in use. The tagged status in the index must
+be current.
 
-  ninstalled = installedlist.size();
-  for ( i = 0; i < ninstalled; i++ )
+*******************************************************************************/
+void filter_by_mask(const BuildIndex & index, const BuildSet & mask,
+                    std::vector<CategoryListItem> & categories,
+                    WINDOW *blistboxwin, CategoryListBox & clistbox,
+                    std::vector<BuildListBox> & blistboxes,
+                    unsigned int & nfiltered)
+{
+  unsigned int i, ncategories, first, last, nmatches;
+  BuildSet untagged;
+
+  untagged = mask;
+  untagged.subtract(index.status(STATUS_TAGGED));
+
+  ncategories = index.numCategories();
+  blistboxes.resize(0);
+  blistboxes.reserve(ncategories+1);
+  clistbox.clearList();
+  clistbox.setActivated(true);
+  nfiltered = 0; 
+
+  for ( i = 0; i < ncategories; i++ )
   {
-    isdep = false;
-    for ( j = 0; j < ninstalled; j++ )
-    {
-      if (j == i) { continue; }
-      deplist = split(installedlist[j]->getProp("requires"));
-      ndeps = deplist.size();
-      for ( k = 0; k < ndeps; k++ )
-      {
-        if (deplist[k] == installedlist[i]->name())
-        {
-          isdep = true;
-          break;
-        }
-      }
-      if (isdep) { break; }
-    } 
-    if (! isdep) { nondeplist.push_back(installedlist[i]); }
+    first = index.first(i);
+    last = index.first(i+1);
+    nmatches = mask.count(first, last);
+    if (nmatches == 0) { continue; }
+
+    // Category is tagged if none of its matches are untagged
+
+    clistbox.addItem(&categories[i]);
+    categories[i].setBoolProp("tagged", untagged.count(first, last) == 0);
+
+    BuildListBox blistbox;
+    blistbox.setWindow(blistboxwin);
+    blistbox.setName(categories[i].name());
+    blistbox.setActivated(false);
+    blistboxes.push_back(blistbox);
+    blistboxes.back().setSource(&index.categoryBuilds(i), &mask, first);
+    nfiltered += nmatches;
   } 
 
-  return nondeplist;
+  // Initialize with empty lists if filter is empty
+
+  if (nfiltered == 0) { add_empty_list(blistboxwin, blistboxes); }
 }
 
 /*******************************************************************************
 
-Overwrites input lists using the contents of BuildListBoxes and CategoryListBox.
+Filters the displayed SlackBuilds by status. The result goes in filtered,
+which the lists refer to. With overwrite (cumulative filters), it also
+becomes the displayed set that the next filter starts from.
 
 *******************************************************************************/
-void overwrite_lists(std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                     std::vector<CategoryListItem *> & categories,
-                     std::vector<BuildListBox> & blistboxes,
-                     CategoryListBox & clistbox)
+void filter_by_status(BuildIndex & index, build_status status,
+                      BuildSet & displayed, BuildSet & filtered,
+                      std::vector<CategoryListItem> & categories,
+                      WINDOW *blistboxwin, CategoryListBox & clistbox,
+                      std::vector<BuildListBox> & blistboxes,
+                      unsigned int & nfiltered, bool overwrite)
 {
-  unsigned int i, j, nbuilds, ncategories;
+  index.refresh();
+  filtered = displayed;
+  filtered &= index.status(status);
+  filter_by_mask(index, filtered, categories, blistboxwin, clistbox,
+                 blistboxes, nfiltered);
+  if (overwrite) { displayed = filtered; }
+}
 
-  categories.clear();
-  slackbuilds.clear();
-  ncategories = clistbox.numItems();
-  categories.resize(ncategories);
-  slackbuilds.resize(ncategories);
-  for ( i = 0; i < ncategories; i++ )
+/*******************************************************************************
+
+Filters the displayed SlackBuilds by non-dependencies. all_slackbuilds is the
+list of all slackbuilds in the repo, from which the dependency graph is made.
+
+*******************************************************************************/
+void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
+                    BuildIndex & index, BuildSet & displayed,
+                    BuildSet & filtered,
+                    std::vector<CategoryListItem> & categories,
+                    WINDOW *blistboxwin, CategoryListBox & clistbox,
+                    std::vector<BuildListBox> & blistboxes,
+                    unsigned int & nnondeps, bool overwrite)
+{
+  index.setNonDeps(dependency_graph.nondeps(all_slackbuilds));
+  filter_by_status(index, STATUS_NONDEP, displayed, filtered, categories,
+                   blistboxwin, clistbox, blistboxes, nnondeps, overwrite);
+}
+
+/*******************************************************************************
+
+Gets the set of SlackBuilds in the lists, e.g. to use the result of a search
+that refined the lists directly as the displayed set
+
+*******************************************************************************/
+void lists_to_set(const BuildIndex & index,
+                  const std::vector<BuildListBox> & blistboxes, BuildSet & set)
+{
+  std::vector<BuildListItem *> items;
+  unsigned int i, j, nlists;
+  int idx;
+
+  set.resize(index.size());
+  nlists = blistboxes.size();
+  for ( i = 0; i < nlists; i++ )
   {
-    categories[i] = static_cast<CategoryListItem *>(clistbox.itemByIdx(i));
-    nbuilds = blistboxes[i].numItems();
-    slackbuilds[i].resize(nbuilds);
-    for ( j = 0; j < nbuilds; j++ )
+    blistboxes[i].filteredItems(items);
+    for ( j = 0; j < items.size(); j++ )
     {
-      slackbuilds[i][j] = static_cast<BuildListItem *>(blistboxes[i].itemByIdx(j));
+      idx = index.indexOf(items[j]);
+      if (idx != -1) { set.set(idx); }
     }
   }
 }
 
 /*******************************************************************************
 
-Filters lists by bool function taking BuildListItem as parameter.
+Checks SlackBuild name against a search term. For a case insensitive search,
+term must already be lower case.
 
 *******************************************************************************/
-void filter_by_func(std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                    bool (*func)(const BuildListItem &),
-                    std::vector<CategoryListItem *> & categories,
-                    WINDOW *blistboxwin, CategoryListBox & clistbox,
-                    std::vector<BuildListBox> & blistboxes,
-                    unsigned int & nfiltered, bool overwrite)
+static bool name_matches(const std::string & term, const std::string & name,
+                         bool case_sensitive, bool whole_word)
 {
-  unsigned int i, j, ncategories, nbuilds, nfiltered_categories;
-  bool category_found;
-  BuildListBox initlistbox;
+  std::string tomatch;
 
-  ncategories = categories.size();
-  blistboxes.resize(0);
-  clistbox.clearList();
-  clistbox.setActivated(true);
-  nfiltered = 0; 
-  nfiltered_categories = 0;
+  if (case_sensitive) { tomatch = name; }
+  else { tomatch = string_to_lower(name); }
+  if (whole_word) { return (term == tomatch); }
+  else { return (tomatch.find(term) != std::string::npos); }
+}
 
-  for ( i = 0; i < ncategories; i++ )
+/*******************************************************************************
+
+Filters the displayed SlackBuilds by search term
+
+*******************************************************************************/
+void filter_search(BuildIndex & index, BuildSet & displayed,
+                   BuildSet & filtered,
+                   std::vector<CategoryListItem> & categories,
+                   WINDOW *blistboxwin, CategoryListBox & clistbox,
+                   std::vector<BuildListBox> & blistboxes,
+                   unsigned int & nsearch, const std::string & searchterm,
+                   bool case_sensitive, bool whole_word, bool search_readmes,
+                   bool overwrite)
+{
+  unsigned int i, nbuilds;
+  std::string term, readme_file;
+  bool match, use_index;
+  std::vector<char> is_candidate;
+  const BuildListItem *build;
+  int doc;
+
+  // For case insensitive search, convert both to lower case
+
+  if (case_sensitive) { term = searchterm; }
+  else { term = string_to_lower(searchterm); }
+
+  // The README index rules out READMEs that cannot contain the search term
+
+  use_index = false;
+  if (search_readmes && readme_index_ready())
+    use_index = (readme_index.candidates(searchterm, whole_word,
+                                         is_candidate) == 0);
+
+  index.refresh();
+  nbuilds = index.size();
+  filtered.resize(nbuilds);
+  for ( i = displayed.next(0); i < nbuilds; i = displayed.next(i+1) )
   {
-    category_found = false;
-    nbuilds = slackbuilds[i].size();
-    for ( j = 0; j < nbuilds; j++ )
+    build = index.build(i);
+
+    // Check for search term in SlackBuild name
+
+    match = name_matches(term, build->name(), case_sensitive, whole_word);
+
+    // Check for search term in README
+
+    if ( (! match) && (search_readmes) )
     {
-      if (func(*slackbuilds[i][j]))
+      if (use_index)
       {
-        if (! category_found)
-        {
-          category_found = true;
-          clistbox.addItem(categories[i]);
-          BuildListBox blistbox;
-          blistbox.setWindow(blistboxwin);
-          blistbox.setName(categories[i]->name());
-          blistbox.setActivated(false);
-          nfiltered_categories++;
-          blistboxes.push_back(blistbox);
-        }
-        blistboxes[nfiltered_categories-1].addItem(slackbuilds[i][j]);
-        nfiltered++;
+        doc = readme_index.docId(build->category(), build->name());
+        if ( (doc != -1) && (! is_candidate[doc]) ) { continue; }
       }
+      readme_file = settings::repo_dir + "/" + build->category() + "/"  +
+                    build->name() + "/README";
+      match = find_in_file(searchterm, readme_file, whole_word,
+                           case_sensitive);
     }
-  } 
-
-  // Check whether categories should be tagged
-
-  for ( i = 0; i < nfiltered_categories; i++ )
-  {
-    if (blistboxes[i].allTagged()) 
-      clistbox.itemByIdx(i)->setBoolProp("tagged", true);
-    else 
-      clistbox.itemByIdx(i)->setBoolProp("tagged", false);
-  }
-
-  // Initialize with empty lists if filter is empty
 
-  if (nfiltered == 0)
-  {
-    initlistbox.setWindow(blistboxwin);
-    initlistbox.setActivated(false);
-    initlistbox.setName("SlackBuilds");
-    blistboxes.push_back(initlistbox);
+    if (match) { filtered.set(i); }
   }
 
-  // Overwrite input lists if requested
-  if (overwrite)
-    overwrite_lists(slackbuilds, categories, blistboxes, clistbox);
+  filter_by_mask(index, filtered, categories, blistboxwin, clistbox,
+                 blistboxes, nsearch);
+  if (overwrite) { displayed = filtered; }
 }
 
 /*******************************************************************************
 
-Filters lists by non-dependencies. all_slackbuilds is the list of all
-slackbuilds in the repo; slackbuilds is the input list (which could
-be the same as all_slackbuilds).
+Filters the displayed SlackBuilds by fuzzy search of names and short
+descriptions. Categories are listed in order of their best match, and
+SlackBuilds in each category from best to worst match, so the lists are
+filled right away. The matches also go in filtered, as with the other
+filters.
 
 *******************************************************************************/
-void filter_nondeps(std::vector<std::vector<BuildListItem> > & all_slackbuilds,
-                    std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                    std::vector<CategoryListItem *> & categories,
-                    WINDOW *blistboxwin, CategoryListBox & clistbox,
-                    std::vector<BuildListBox> & blistboxes,
-                    unsigned int & nnondeps, bool overwrite)
+void filter_fuzzy(BuildIndex & index, BuildSet & displayed,
+                  BuildSet & filtered,
+                  std::vector<CategoryListItem> & categories,
+                  const FuzzyIndex & fuzzy_index,
+                  WINDOW *blistboxwin, CategoryListBox & clistbox,
+                  std::vector<BuildListBox> & blistboxes,
+                  unsigned int & nsearch, const std::string & searchterm,
+                  bool overwrite)
 {
-  unsigned int i, j, k, ncategories, nbuilds, nfiltered_categories;
-  std::vector<std::string> filtered_categories;
-  bool category_found;
-  BuildListBox initlistbox;
-  std::vector<BuildListItem *> allnondeplist, nondeplist;
+  unsigned int i, k, ncategories, nmatches, nsearch_categories;
+  std::vector<fuzzymatch> matches;
+  std::unordered_map<std::string, unsigned int> category_of;
+  std::unordered_map<std::string, unsigned int>::const_iterator it;
+  std::vector<int> listbox_of;
+  int idx;
+
+  fuzzy_index.search(searchterm, matches);
 
-  // Get a list of all nondeps
-  allnondeplist = list_nondeps(all_slackbuilds);
-  nnondeps = allnondeplist.size();
-  ncategories = categories.size();
+  ncategories = index.numCategories();
+  for ( i = 0; i < ncategories; i++ ) { category_of[categories[i].name()] = i; }
+
+  index.refresh();
+  filtered.resize(index.size());
   blistboxes.resize(0);
+  blistboxes.reserve(ncategories+1);
   clistbox.clearList();
   clistbox.setActivated(true);
-  filtered_categories.resize(0);
-
-  // Recreate nondeplist based only on slackbuilds in the input list
-  for ( i = 0; i < ncategories; i++ )
-  {
-      nbuilds = slackbuilds[i].size();
-      for ( j = 0; j < nbuilds; j++ )
-      {
-          for ( k = 0; k < nnondeps; k++ )
-          {
-              if (slackbuilds[i][j]->name() == allnondeplist[k]->name())
-              {
-                  nondeplist.push_back(slackbuilds[i][j]);
-                  break;
-              }
-          }
-      }
-  }
-  nnondeps = nondeplist.size();
+  listbox_of.assign(ncategories, -1);
+  nsearch = 0;
+  nsearch_categories = 0;
 
-  for ( i = 0; i < nnondeps; i++ )
+  nmatches = matches.size();
+  for ( k = 0; k < nmatches; k++ )
   {
-    category_found = false;
-    nfiltered_categories = filtered_categories.size();
-    for ( j = 0; j < nfiltered_categories; j++ )
+    idx = index.indexOf(matches[k].build);
+    if ( (idx == -1) || (! displayed.test(idx)) ) { continue; }
+    it = category_of.find(matches[k].build->category());
+    if (it == category_of.end()) { continue; }
+    i = it->second;
+    filtered.set(idx);
+
+    if (listbox_of[i] == -1)
     {
-      if (nondeplist[i]->getProp("category") == filtered_categories[j])
-      {
-        blistboxes[j].addItem(nondeplist[i]);
-        category_found = true;
-        break;
-      }
-    }
-    if (! category_found)
-    {
-      for ( j = 0; j < ncategories; j++ )
-      {
-        if (nondeplist[i]->getProp("category") == categories[j]->name())
-        {
-          clistbox.addItem(categories[j]);
-          BuildListBox blistbox;
-          blistbox.setWindow(blistboxwin);
-          blistbox.setName(categories[j]->name());
-          blistbox.setActivated(false);
-          blistbox.addItem(nondeplist[i]);
-          blistboxes.push_back(blistbox);
-          filtered_categories.push_back(nondeplist[i]->getProp("category"));
-          break;
-        }
-      }
+      clistbox.addItem(&categories[i]);
+      BuildListBox blistbox; 
+      blistbox.setWindow(blistboxwin);
+      blistbox.setName(categories[i].name());
+      blistbox.setActivated(false);
+      listbox_of[i] = nsearch_categories;
+      nsearch_categories++;
+      blistboxes.push_back(blistbox);
     }
+    blistboxes[listbox_of[i]].addItem(matches[k].build);
+    nsearch++;
   }
 
   // Check whether categories should be tagged
 
-  nfiltered_categories = filtered_categories.size();
-  for ( j = 0; j < nfiltered_categories; j++ )
+  for ( i = 0; i < nsearch_categories; i++ )
   {
-    if (blistboxes[j].allTagged()) 
-      clistbox.itemByIdx(j)->setBoolProp("tagged", true);
-    else 
-      clistbox.itemByIdx(j)->setBoolProp("tagged", false);
+    clistbox.itemByIdx(i)->setBoolProp("tagged", blistboxes[i].allTagged());
   }
 
   // Initialize with empty lists if filter is empty
 
-  if (nnondeps == 0)
-  {
-    initlistbox.setWindow(blistboxwin);
-    initlistbox.setActivated(false);
-    initlistbox.setName("SlackBuilds");
-    blistboxes.push_back(initlistbox);
-  }
+  if (nsearch == 0) { add_empty_list(blistboxwin, blistboxes); }
 
-  // Overwrite input lists if requested
-  if (overwrite)
-    overwrite_lists(slackbuilds, categories, blistboxes, clistbox);
+  if (overwrite) { displayed = filtered; }
 }
 
 /*******************************************************************************
 
-Filters lists by search term
+Narrows down the displayed lists to SlackBuilds whose names contain the search
+term. Meant for searching as the user types: when the term only gets longer,
+the previous results can be refined instead of searching everything again.
+Lists that lose items are rebuilt, lists that lose all their items are
+dropped along with their category, and the rest are left alone.
 
 *******************************************************************************/
-void filter_search(std::vector<std::vector<BuildListItem *> > & slackbuilds,
-                   std::vector<CategoryListItem *> & categories,
-                   WINDOW *blistboxwin, CategoryListBox & clistbox,
+void refine_search(WINDOW *blistboxwin, CategoryListBox & clistbox,
                    std::vector<BuildListBox> & blistboxes,
                    unsigned int & nsearch, const std::string & searchterm,
-                   bool case_sensitive, bool whole_word, bool search_readmes,
-                   bool overwrite)
+                   bool case_sensitive)
 {
-  unsigned int i, j, nbuilds, ncategories, nsearch_categories;
-  std::string term, tomatch, readme_file;
-  bool match, category_found;
-  BuildListBox initlistbox;
-
-  // For case insensitive search, convert both to lower case
+  unsigned int i, j, k, nbuilds, ncategories, nkept;
+  std::string term;
+  std::vector<BuildListItem *> builds, matches;
+  std::vector<ListItem *> kept_categories;
 
   if (case_sensitive) { term = searchterm; }
   else { term = string_to_lower(searchterm); }
 
-  ncategories = categories.size();
-  blistboxes.resize(0);
-  clistbox.clearList();
-  clistbox.setActivated(true);
-  nsearch = 0;
-  nsearch_categories = 0;
+  // Scan without filling lists that are still pending, so that only the
+  // lists that lose items need to be rebuilt
 
+  ncategories = clistbox.numItems();
+  nkept = 0;
+  nsearch = 0;
   for ( i = 0; i < ncategories; i++ )
   {
-    category_found = false;
-    nbuilds = slackbuilds[i].size();
+    matches.resize(0);
+    blistboxes[i].filteredItems(builds);
+    nbuilds = builds.size();
     for ( j = 0; j < nbuilds; j++ )
     {
-      // Check for search term in SlackBuild name
-
-      if (case_sensitive) { tomatch = slackbuilds[i][j]->name(); }
-      else { tomatch = string_to_lower(slackbuilds[i][j]->name()); }
-      if (whole_word) { match = (term == tomatch); }
-      else { match = (tomatch.find(term) != std::string::npos); }
-
-      // Check for search term in README
-
-      if ( (! match) && (search_readmes) )
-      {
-        readme_file = settings::repo_dir + "/" + 
-                    slackbuilds[i][j]->getProp("category") + "/"  +
-                    slackbuilds[i][j]->name() + "/README";
-        match = find_in_file(searchterm, readme_file, whole_word,
-                             case_sensitive);
-      }
-
-      if (! match) { continue; }
+      if (name_matches(term, builds[j]->name(), case_sensitive, false))
+        matches.push_back(builds[j]);
+    }
+    if (matches.size() == 0) { continue; }
 
-      if (! category_found)
+    if (matches.size() < nbuilds)
+    {
+      blistboxes[i].clearList();
+      for ( j = 0; j < matches.size(); j++ )
       {
-        category_found = true;
-        clistbox.addItem(categories[i]);
-        BuildListBox blistbox; 
-        blistbox.setWindow(blistboxwin);
-        blistbox.setName(categories[i]->name());
-        blistbox.setActivated(false);
-        nsearch_categories++;
-        blistboxes.push_back(blistbox);
+        blistboxes[i].addItem(matches[j]);
       }
-      blistboxes[nsearch_categories-1].addItem(slackbuilds[i][j]);
-      nsearch++;
-    } 
+      clistbox.itemByIdx(i)->setBoolProp("tagged",
+                                         blistboxes[i].allTagged());
+    }
+    if (nkept < i) { blistboxes[nkept] = blistboxes[i]; }
+    kept_categories.push_back(clistbox.itemByIdx(i));
+    nkept++;
+    nsearch += matches.size();
   }
+  blistboxes.resize(nkept);
 
-  // Check whether categories should be tagged
+  // Only rebuild the categories list if some were dropped
 
-  for ( i = 0; i < nsearch_categories; i++ )
+  if (nkept < ncategories)
   {
-    if (blistboxes[i].allTagged()) 
-      clistbox.itemByIdx(i)->setBoolProp("tagged", true);
-    else 
-      clistbox.itemByIdx(i)->setBoolProp("tagged", false);
+    clistbox.clearList();
+    for ( k = 0; k < nkept; k++ ) { clistbox.addItem(kept_categories[k]); }
   }
 
-  // Initialize with empty lists if filter is empty
-
-  if (nsearch == 0)
-  {
-    initlistbox.setWindow(blistboxwin);
-    initlistbox.setActivated(false);
-    initlistbox.setName("SlackBuilds");
-    blistboxes.push_back(initlistbox);
-  }
+  // Empty list if nothing matches, as in filter_search
 
-  // Overwrite input lists if requested
-  if (overwrite)
-    overwrite_lists(slackbuilds, categories, blistboxes, clistbox);
+  if (nsearch == 0) { add_empty_list(blistboxwin, blistboxes); }
 }
@@ -0,0 +1,58 @@
+#include <string>
+#include <fstream>
+#include <stdint.h>
+#include "index_io.h"
+
+/*******************************************************************************
+
+Writing
+
+*******************************************************************************/
+void write_uint(std::ofstream & file, uint32_t value)
+{
+  file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void write_int64(std::ofstream & file, int64_t value)
+{
+  file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void write_string(std::ofstream & file, const std::string & value)
+{
+  write_uint(file, value.size());
+  file.write(value.data(), value.size());
+}
+
+/*******************************************************************************
+
+Reading
+
+*******************************************************************************/
+int read_uint(const std::string & buf, std::size_t & pos, uint32_t & value)
+{
+  if (pos + sizeof(value) > buf.size()) { return 1; }
+  buf.copy(reinterpret_cast<char *>(&value), sizeof(value), pos);
+  pos += sizeof(value);
+  return 0;
+}
+
+int read_int64(const std::string & buf, std::size_t & pos, int64_t & value)
+{
+  if (pos + sizeof(value) > buf.size()) { return 1; }
+  buf.copy(reinterpret_cast<char *>(&value), sizeof(value), pos);
+  pos += sizeof(value);
+  return 0;
+}
+
+int read_string(const std::string & buf, std::size_t & pos,
+                std::string & value)
+{
+  uint32_t len;
+
+  if (read_uint(buf, pos, len) != 0) { return 1; }
+  if (pos + len > buf.size()) { return 1; }
+  value = buf.substr(pos, len);
+  pos += len;
+  return 0;
+}
@@ -35,6 +35,8 @@ namespace settings
   std::string layout;
   bool resolve_deps, confirm_changes, enable_color, rebuild_inv_deps;
   bool save_buildopts, warn_invalid_pkgnames, cumulative_filters;
+  bool watch_files, pipeline_builds;
+  int jobs, build_jobs, fetch_jobs;
 }
 
 Color colors;
@@ -170,6 +172,20 @@ int read_config(const std::string & conf_file)
   if (! cfg.lookupValue("cumulative_filters", cumulative_filters))
     cumulative_filters = true;
 
+  if (! cfg.lookupValue("watch_files", watch_files))
+    watch_files = false;
+
+  if ( (! cfg.lookupValue("jobs", jobs)) || (jobs < 0) ) { jobs = 0; }
+
+  if ( (! cfg.lookupValue("build_jobs", build_jobs)) || (build_jobs < 1) )
+    build_jobs = 1;
+
+  if ( (! cfg.lookupValue("fetch_jobs", fetch_jobs)) || (fetch_jobs < 1) )
+    fetch_jobs = 1;
+
+  if (! cfg.lookupValue("pipeline_builds", pipeline_builds))
+    pipeline_builds = false;
+
   if (! cfg.lookupValue("layout", layout)) { layout = "horizontal"; }
   else if ( (layout != "horizontal") && (layout != "vertical") )
   {
@@ -375,6 +391,11 @@ int write_config(const std::string & conf_file)
   root.add("color_theme", Setting::TypeString) = color_theme;
   root.add("warn_invalid_pkgnames", Setting::TypeBoolean) = warn_invalid_pkgnames;
   root.add("cumulative_filters", Setting::TypeBoolean) = cumulative_filters;
+  root.add("watch_files", Setting::TypeBoolean) = watch_files;
+  root.add("jobs", Setting::TypeInt) = jobs;
+  root.add("build_jobs", Setting::TypeInt) = build_jobs;
+  root.add("fetch_jobs", Setting::TypeInt) = fetch_jobs;
+  root.add("pipeline_builds", Setting::TypeBoolean) = pipeline_builds;
 
   // Overwrite config file
 
@@ -131,6 +131,29 @@ std::string remove_comment(const std::string & instr, char delim)
 
 /*******************************************************************************
 
+Quotes a string for the shell: wraps it in single quotes and turns each
+embedded ' into '\''
+
+*******************************************************************************/
+std::string shell_quote(const std::string & instr)
+{
+  std::string quoted;
+  unsigned int i, len;
+
+  len = instr.size();
+  quoted = "'";
+  for ( i = 0; i < len; i++ )
+  {
+    if (instr[i] == '\'') { quoted += "'\\''"; }
+    else { quoted += instr[i]; }
+  }
+  quoted += "'";
+
+  return quoted;
+}
+
+/*******************************************************************************
+
 Splits a string into a vector of strings. Adapted from the answer here:
 http://stackoverflow.com/questions/236129/split-a-string-in-c#236803
 